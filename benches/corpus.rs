@@ -0,0 +1,198 @@
+//! Reproducible benchmark harness over a DIMACS corpus.
+//!
+//! Runs every instance of a corpus across a list of thread counts and emits
+//! one JSON object per (instance, thread count) pair on stdout, so runs can
+//! be diffed between commits with ordinary text tools:
+//!
+//! ```text
+//! PARKISSAT_BENCH_CORPUS=/path/to/cnfs cargo bench
+//! ```
+//!
+//! Environment:
+//! - `PARKISSAT_BENCH_CORPUS`: directory scanned for `.cnf`, `.dimacs`,
+//!   `.gz`, and `.xz` files. Without it, a built-in pigeonhole instance is
+//!   benchmarked so `cargo bench` works out of the box.
+//! - `PARKISSAT_BENCH_THREADS`: comma-separated thread counts (default
+//!   `1,2,4,8`, capped at the number of online CPUs).
+//! - `PARKISSAT_BENCH_TIMEOUT`: per-solve timeout in seconds (default 60).
+//!
+//! Each record reports wall time, the speedup against the single-threaded
+//! run of the same instance, the answer, the winning member, and the
+//! aggregate `ParkissatStatistics` counters.
+
+use std::time::{Duration, Instant};
+
+use parkissat_sys::{ParkissatSolver, SolverConfig, SolverResult, SolverStatistics};
+
+struct Record {
+    instance: String,
+    threads: usize,
+    wall: Duration,
+    speedup: f64,
+    result: SolverResult,
+    winner: Option<usize>,
+    stats: SolverStatistics,
+}
+
+fn result_name(result: SolverResult) -> &'static str {
+    match result {
+        SolverResult::Sat => "sat",
+        SolverResult::Unsat => "unsat",
+        SolverResult::Unknown => "unknown",
+    }
+}
+
+fn emit(record: &Record) {
+    println!(
+        "{{\"instance\":\"{}\",\"threads\":{},\"wall_s\":{:.6},\"speedup\":{:.3},\
+         \"result\":\"{}\",\"winner\":{},\"propagations\":{},\"decisions\":{},\
+         \"conflicts\":{},\"restarts\":{},\"mem_peak_kb\":{:.1}}}",
+        record.instance,
+        record.threads,
+        record.wall.as_secs_f64(),
+        record.speedup,
+        result_name(record.result),
+        record
+            .winner
+            .map(|w| w.to_string())
+            .unwrap_or_else(|| "null".to_string()),
+        record.stats.propagations,
+        record.stats.decisions,
+        record.stats.conflicts,
+        record.stats.restarts,
+        record.stats.memory_peak_kb,
+    );
+}
+
+/// Pigeonhole n+1 pigeons into n holes: small to state, exponentially hard
+/// for resolution, and UNSAT, so no lucky early SAT answer skews the curve.
+fn add_pigeonhole(solver: &mut ParkissatSolver, holes: i32) {
+    let pigeons = holes + 1;
+    let var = |p: i32, h: i32| (p - 1) * holes + h;
+    for p in 1..=pigeons {
+        let clause: Vec<i32> = (1..=holes).map(|h| var(p, h)).collect();
+        solver.add_clause(&clause).expect("failed to add clause");
+    }
+    for h in 1..=holes {
+        for p1 in 1..=pigeons {
+            for p2 in (p1 + 1)..=pigeons {
+                solver
+                    .add_clause(&[-var(p1, h), -var(p2, h)])
+                    .expect("failed to add clause");
+            }
+        }
+    }
+}
+
+fn corpus_files(dir: &str) -> Vec<std::path::PathBuf> {
+    let mut files: Vec<_> = std::fs::read_dir(dir)
+        .unwrap_or_else(|e| panic!("cannot read corpus directory {}: {}", dir, e))
+        .filter_map(|entry| entry.ok().map(|e| e.path()))
+        .filter(|path| {
+            matches!(
+                path.extension().and_then(|e| e.to_str()),
+                Some("cnf") | Some("dimacs") | Some("gz") | Some("xz")
+            )
+        })
+        .collect();
+    files.sort();
+    files
+}
+
+fn thread_counts() -> Vec<usize> {
+    let cpus = num_cpus::get();
+    std::env::var("PARKISSAT_BENCH_THREADS")
+        .map(|spec| {
+            spec.split(',')
+                .filter_map(|t| t.trim().parse().ok())
+                .collect()
+        })
+        .unwrap_or_else(|_| vec![1, 2, 4, 8])
+        .into_iter()
+        .filter(|&t| t >= 1 && t <= cpus)
+        .collect()
+}
+
+fn bench_one(
+    instance: &str,
+    load: &dyn Fn(&mut ParkissatSolver),
+    threads: usize,
+    timeout: i32,
+    base_wall: Option<Duration>,
+) -> Record {
+    let mut solver = ParkissatSolver::new().expect("failed to create solver");
+    let config = SolverConfig {
+        num_threads: threads as isize,
+        timeout: Duration::from_secs(timeout as u64),
+        ..Default::default()
+    };
+    solver.configure(&config).expect("failed to configure solver");
+    load(&mut solver);
+
+    let start = Instant::now();
+    let result = solver.solve().expect("failed to solve");
+    let wall = start.elapsed();
+
+    Record {
+        instance: instance.to_string(),
+        threads,
+        wall,
+        speedup: base_wall
+            .map(|base| base.as_secs_f64() / wall.as_secs_f64().max(1e-9))
+            .unwrap_or(1.0),
+        result,
+        winner: solver.winner().expect("failed to query winner"),
+        stats: solver.get_statistics().expect("failed to read statistics"),
+    }
+}
+
+fn bench_instance(instance: &str, load: &dyn Fn(&mut ParkissatSolver), timeout: i32) {
+    let mut base_wall = None;
+    for threads in thread_counts() {
+        let record = bench_one(instance, load, threads, timeout, base_wall);
+        if threads == 1 {
+            base_wall = Some(record.wall);
+        }
+        emit(&record);
+    }
+}
+
+fn main() {
+    let timeout: i32 = std::env::var("PARKISSAT_BENCH_TIMEOUT")
+        .ok()
+        .and_then(|t| t.parse().ok())
+        .unwrap_or(60);
+
+    match std::env::var("PARKISSAT_BENCH_CORPUS") {
+        Ok(dir) => {
+            let files = corpus_files(&dir);
+            if files.is_empty() {
+                eprintln!("no CNF files found in {}", dir);
+                std::process::exit(1);
+            }
+            for path in files {
+                let name = path
+                    .file_name()
+                    .and_then(|n| n.to_str())
+                    .unwrap_or("?")
+                    .to_string();
+                let path = path.clone();
+                bench_instance(
+                    &name,
+                    &move |solver: &mut ParkissatSolver| {
+                        solver.load_dimacs(&path).expect("failed to load DIMACS");
+                    },
+                    timeout,
+                );
+            }
+        }
+        Err(_) => {
+            // No corpus configured: built-in hard instance
+            bench_instance(
+                "builtin-php9",
+                &|solver: &mut ParkissatSolver| add_pigeonhole(solver, 9),
+                timeout,
+            );
+        }
+    }
+}
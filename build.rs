@@ -78,6 +78,12 @@ fn main() {
         .flag("-DNDEBUG")
         .flag("-fopenmp")  // Enable OpenMP
         .flag("-fPIC");
+
+    // Hot-path instrumentation is compiled in only on request; the default
+    // build keeps the recording sites as dead code the compiler deletes.
+    if env::var("CARGO_FEATURE_PERF_INSTRUMENTATION").is_ok() {
+        build.define("PARKISSAT_PERF", None);
+    }
     
     // Add painless-src object files to the build first
     let painless_objects = [
@@ -15,11 +15,18 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         random_seed: 42,
         enable_preprocessing: true,
         verbosity: 1,
+        ..SolverConfig::default()
     };
     
     println!("Configuring solver with num_threads = -1 (auto-detect)");
     solver.configure(&config)?;
-    
+
+    let layout = solver.layout()?;
+    println!(
+        "Chosen layout: {} threads on {} physical cores across {} NUMA node(s) (auto: {})",
+        layout.num_threads, layout.physical_cores, layout.numa_nodes, layout.auto_selected
+    );
+
     // Add a simple satisfiable problem
     solver.add_clause(&[1, 2])?;
     solver.add_clause(&[-1, 2])?;
@@ -54,6 +61,7 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         random_seed: 42,
         enable_preprocessing: true,
         verbosity: 1,
+        ..SolverConfig::default()
     };
     
     solver2.configure(&config2)?;
@@ -25,13 +25,19 @@ pub enum ParkissatError {
     
     /// No solution available (solver hasn't been run or returned UNSAT/UNKNOWN)
     NoSolution,
+
+    /// Pop was called without a matching push
+    NoOpenScope,
     
     /// File I/O error
     IoError(String),
     
     /// Solver was interrupted
     Interrupted,
-    
+
+    /// An asynchronous solve is still in flight
+    SolveInProgress,
+
     /// Internal solver error
     InternalError(String),
 }
@@ -57,12 +63,18 @@ impl fmt::Display for ParkissatError {
             ParkissatError::NoSolution => {
                 write!(f, "No solution available")
             }
+            ParkissatError::NoOpenScope => {
+                write!(f, "No open scope to pop")
+            }
             ParkissatError::IoError(msg) => {
                 write!(f, "I/O error: {}", msg)
             }
             ParkissatError::Interrupted => {
                 write!(f, "Solver was interrupted")
             }
+            ParkissatError::SolveInProgress => {
+                write!(f, "An asynchronous solve is still in flight")
+            }
             ParkissatError::InternalError(msg) => {
                 write!(f, "Internal solver error: {}", msg)
             }
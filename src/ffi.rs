@@ -14,4 +14,17 @@ include!(concat!(env!("OUT_DIR"), "/bindings.rs"));
 // Re-export the result constants for easier access
 pub const PARKISSAT_SAT: ParkissatResult = 10;
 pub const PARKISSAT_UNSAT: ParkissatResult = 20;
-pub const PARKISSAT_UNKNOWN: ParkissatResult = 0;
\ No newline at end of file
+pub const PARKISSAT_UNKNOWN: ParkissatResult = 0;
+
+// Re-export the solve mode constants for easier access
+pub const PARKISSAT_MODE_PORTFOLIO: ParkissatSolveMode = 0;
+pub const PARKISSAT_MODE_CUBE_AND_CONQUER: ParkissatSolveMode = 1;
+
+// Re-export the pin policy constants for easier access
+pub const PARKISSAT_PIN_NONE: ParkissatPinPolicy = 0;
+pub const PARKISSAT_PIN_CORE: ParkissatPinPolicy = 1;
+pub const PARKISSAT_PIN_NODE: ParkissatPinPolicy = 2;
+
+// Re-export the diversification plan constants for easier access
+pub const PARKISSAT_DIV_SEED_ONLY: ParkissatDiversificationPlan = 0;
+pub const PARKISSAT_DIV_PRESETS: ParkissatDiversificationPlan = 1;
\ No newline at end of file
@@ -8,7 +8,7 @@ pub mod ffi;
 pub mod wrapper;
 pub mod error;
 
-pub use wrapper::{ParkissatSolver, SolverConfig, SolverResult, SolverStatistics};
+pub use wrapper::{DiversificationPlan, ParkissatSolver, PinPolicy, PortfolioLayout, SolveMode, SolverConfig, SolverResult, SolverStatistics};
 pub use error::{ParkissatError, Result};
 
 #[cfg(test)]
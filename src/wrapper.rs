@@ -7,10 +7,50 @@ use std::os::raw::c_int;
 use std::ptr;
 use std::time::Duration;
 
+/// Parallel solve engine selection
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum SolveMode {
+    /// Diversified portfolio: every solver races on the full problem
+    Portfolio,
+    /// Cube-and-conquer: the search space is split into cubes that the
+    /// workers drain from a shared queue
+    CubeAndConquer,
+}
+
+/// Worker placement policy for the portfolio threads
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum PinPolicy {
+    /// Leave thread placement to the kernel
+    None,
+    /// Pin each worker to one core, dealt across NUMA nodes; first touch
+    /// then places every member's hot structures on its own node
+    Core,
+    /// Bind each worker to one NUMA node but let the kernel pick the core
+    Node,
+}
+
+/// Portfolio diversification plan
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum DiversificationPlan {
+    /// Identical parameters for every member, separated by random seed only.
+    /// On large portfolios the members collapse onto similar search
+    /// trajectories, so speedup flattens out.
+    SeedOnly,
+    /// A library of complementary parameter presets — stable vs focused
+    /// restart behaviour, walk-seeded vs saved phases, flipped polarity,
+    /// heavier clause tiers — dealt round-robin across the members on top
+    /// of the per-member seed, so the marginal solver keeps exploring a
+    /// genuinely different trajectory well past 16 threads
+    Presets,
+}
+
 /// Configuration for the ParKissat solver
 #[derive(Debug, Clone)]
 pub struct SolverConfig {
-    /// Number of parallel threads to use (default: 1, -1 = use all available CPUs)
+    /// Number of parallel threads to use (default: 1). `-1` picks the
+    /// portfolio size automatically from the machine's physical-core
+    /// topology and available memory; [`ParkissatSolver::layout`] reports
+    /// the choice made.
     pub num_threads: isize,
     
     /// Timeout in seconds (0 = no timeout)
@@ -21,9 +61,52 @@ pub struct SolverConfig {
     
     /// Enable preprocessing
     pub enable_preprocessing: bool,
-    
+
     /// Verbosity level (0 = quiet)
     pub verbosity: u32,
+
+    /// Parallel solve engine (default: portfolio)
+    pub solve_mode: SolveMode,
+
+    /// Cube-and-conquer splits on 2^depth cubes (0 = auto)
+    pub cube_split_depth: u32,
+
+    /// Worker placement policy (default: leave it to the kernel)
+    pub pin_policy: PinPolicy,
+
+    /// Portfolio diversification plan (default: seed-only)
+    pub diversification_plan: DiversificationPlan,
+
+    /// Deterministic portfolio mode: members advance in fixed conflict-budget
+    /// epochs with barrier-synchronized clause exchange, so the same input
+    /// reproduces the same answer, model, and winner run to run
+    pub enable_deterministic: bool,
+
+    /// Conflicts per deterministic epoch (0 = default)
+    pub deterministic_conflict_budget: u32,
+
+    /// Adaptive portfolio management: periodically relaunch the member with
+    /// the lowest conflict rate under a fresh configuration, reseeded from
+    /// the warm shared clause store (portfolio mode only)
+    pub enable_adaptive: bool,
+
+    /// Collective memory budget in MiB for portfolio solves (0 = unlimited).
+    /// When the members' combined resident memory approaches the budget, the
+    /// heaviest member is shed from the race instead of letting the kernel
+    /// kill the process (portfolio mode only).
+    pub memory_budget_mb: u32,
+
+    /// Enable learned-clause sharing between portfolio members
+    pub enable_clause_sharing: bool,
+
+    /// Maximum LBD of shared clauses (0 = solver default)
+    pub sharing_lbd_limit: u32,
+
+    /// Literals shared per producer per exchange round (0 = default)
+    pub sharing_lit_budget: u32,
+
+    /// Exchange round interval in microseconds (0 = default)
+    pub sharing_interval_us: u32,
 }
 
 impl Default for SolverConfig {
@@ -34,6 +117,18 @@ impl Default for SolverConfig {
             random_seed: 0,
             enable_preprocessing: false,
             verbosity: 0,
+            solve_mode: SolveMode::Portfolio,
+            cube_split_depth: 0,
+            pin_policy: PinPolicy::None,
+            diversification_plan: DiversificationPlan::SeedOnly,
+            enable_deterministic: false,
+            deterministic_conflict_budget: 0,
+            enable_adaptive: false,
+            memory_budget_mb: 0,
+            enable_clause_sharing: false,
+            sharing_lbd_limit: 0,
+            sharing_lit_budget: 0,
+            sharing_interval_us: 0,
         }
     }
 }
@@ -87,12 +182,39 @@ impl From<ffi::ParkissatStatistics> for SolverStatistics {
     }
 }
 
+/// Portfolio layout chosen at configure time
+#[derive(Debug, Clone, Copy)]
+pub struct PortfolioLayout {
+    /// Portfolio size actually configured
+    pub num_threads: usize,
+    /// Physical cores detected on the machine
+    pub physical_cores: usize,
+    /// NUMA nodes detected on the machine
+    pub numa_nodes: usize,
+    /// True when the portfolio size came from auto-detection
+    pub auto_selected: bool,
+}
+
+impl From<ffi::ParkissatLayout> for PortfolioLayout {
+    fn from(layout: ffi::ParkissatLayout) -> Self {
+        Self {
+            num_threads: layout.num_threads.max(0) as usize,
+            physical_cores: layout.physical_cores.max(0) as usize,
+            numa_nodes: layout.numa_nodes.max(0) as usize,
+            auto_selected: layout.auto_selected,
+        }
+    }
+}
+
 /// Safe wrapper for ParKissat-RS SAT solver
 pub struct ParkissatSolver {
     solver: *mut ffi::ParkissatSolver,
     configured: bool,
     last_result: Option<SolverResult>,
     variable_count: usize,
+    // True from a successful solve_async() until poll() or wait() observes
+    // completion; mutating entry points refuse to run while it is set
+    async_active: bool,
 }
 
 impl ParkissatSolver {
@@ -109,32 +231,66 @@ impl ParkissatSolver {
             configured: false,
             last_result: None,
             variable_count: 0,
+            async_active: false,
         })
     }
-    
+
+    // Guard for entry points that mutate the problem or the portfolio: the
+    // worker threads are walking those structures while an asynchronous
+    // solve is in flight, so mutation must wait until poll() or wait() has
+    // observed completion. interrupt() and add_clause_concurrent() are the
+    // deliberate exceptions — they are built to run against a live solve.
+    fn ensure_no_async_solve(&self) -> Result<()> {
+        if self.async_active {
+            return Err(ParkissatError::SolveInProgress);
+        }
+        Ok(())
+    }
+
     /// Configure the solver with the given options
     pub fn configure(&mut self, config: &SolverConfig) -> Result<()> {
         if self.solver.is_null() {
             return Err(ParkissatError::SolverCreationFailed);
         }
-        
-        // Resolve thread count: -1 means use all available CPUs
-        let actual_threads = if config.num_threads == -1 {
-            num_cpus::get()
-        } else if config.num_threads <= 0 {
+        self.ensure_no_async_solve()?;
+
+        // -1 passes through: the C side resolves it against the machine's
+        // physical-core topology and available memory, and layout() reports
+        // the portfolio size it actually picked
+        if config.num_threads == 0 || config.num_threads < -1 {
             return Err(ParkissatError::InvalidConfiguration(
                 "Number of threads must be positive or -1 for auto-detection".to_string()
             ));
-        } else {
-            config.num_threads as usize
-        };
-        
+        }
+
         let ffi_config = ffi::ParkissatConfig {
-            num_threads: actual_threads as c_int,
+            num_threads: config.num_threads as c_int,
             timeout_seconds: config.timeout.as_secs() as c_int,
             random_seed: config.random_seed as c_int,
             enable_preprocessing: config.enable_preprocessing,
             verbosity: config.verbosity as c_int,
+            solve_mode: match config.solve_mode {
+                SolveMode::Portfolio => ffi::PARKISSAT_MODE_PORTFOLIO,
+                SolveMode::CubeAndConquer => ffi::PARKISSAT_MODE_CUBE_AND_CONQUER,
+            } as c_int,
+            cube_split_depth: config.cube_split_depth as c_int,
+            pin_policy: match config.pin_policy {
+                PinPolicy::None => ffi::PARKISSAT_PIN_NONE,
+                PinPolicy::Core => ffi::PARKISSAT_PIN_CORE,
+                PinPolicy::Node => ffi::PARKISSAT_PIN_NODE,
+            } as c_int,
+            diversification_plan: match config.diversification_plan {
+                DiversificationPlan::SeedOnly => ffi::PARKISSAT_DIV_SEED_ONLY,
+                DiversificationPlan::Presets => ffi::PARKISSAT_DIV_PRESETS,
+            } as c_int,
+            enable_deterministic: config.enable_deterministic,
+            deterministic_conflict_budget: config.deterministic_conflict_budget as c_int,
+            enable_adaptive: config.enable_adaptive,
+            memory_budget_mb: config.memory_budget_mb as c_int,
+            enable_clause_sharing: config.enable_clause_sharing,
+            sharing_lbd_limit: config.sharing_lbd_limit as c_int,
+            sharing_lit_budget: config.sharing_lit_budget as c_int,
+            sharing_interval_us: config.sharing_interval_us as c_int,
         };
         
         unsafe {
@@ -144,18 +300,67 @@ impl ParkissatSolver {
         self.configured = true;
         Ok(())
     }
-    
+
+    /// Drop the formula and all learned state but keep the configured
+    /// portfolio alive for the next problem
+    ///
+    /// Steady-state serving of a stream of unrelated formulas then pays no
+    /// thread churn and no large allocations between problems. The
+    /// configuration, installed callbacks, and open arena slabs are
+    /// retained. Call between solves.
+    pub fn reset(&mut self) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        unsafe {
+            ffi::parkissat_reset(self.solver);
+        }
+
+        self.variable_count = 0;
+        self.last_result = None;
+        Ok(())
+    }
+
+    /// Give the wrapper's packed formula copy back to the system
+    ///
+    /// After a solve, every portfolio member holds its own copy of the
+    /// formula, so the packed copy they were fed from is pure redundancy —
+    /// about 1/(N+1) of the formula-proportional residency for N members.
+    /// Returns the number of bytes freed; 0 when nothing could be freed (a
+    /// solve is running, or some member has not imported the whole formula
+    /// yet). Until [`reset`](Self::reset) starts a fresh formula, the
+    /// features that replay the packed copy are unavailable: adaptive
+    /// relaunch and memory-budget shedding stand down and
+    /// [`save_state`](Self::save_state) fails. Incremental clause additions
+    /// and further solves work normally.
+    pub fn trim_memory(&mut self) -> Result<usize> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let bytes = unsafe { ffi::parkissat_trim_memory(self.solver) };
+        Ok(bytes as usize)
+    }
+
     /// Load a DIMACS file
+    ///
+    /// `.gz` and `.xz` files are decompressed in a streaming pass straight
+    /// into memory (through zlib and the system `xz` tool respectively)
+    /// before the parallel parse, so compressed formulas load directly.
     pub fn load_dimacs<P: AsRef<std::path::Path>>(&mut self, path: P) -> Result<()> {
         if !self.configured {
             return Err(ParkissatError::NotConfigured);
         }
-        
+        self.ensure_no_async_solve()?;
+
         let path_str = path.as_ref().to_str()
             .ok_or_else(|| ParkissatError::IoError("Invalid path".to_string()))?;
-        
+
         let c_path = CString::new(path_str)?;
-        
+
         let success = unsafe {
             ffi::parkissat_load_dimacs(self.solver, c_path.as_ptr())
         };
@@ -167,19 +372,127 @@ impl ParkissatSolver {
         Ok(())
     }
     
+    /// Write a warm-start snapshot of the solver state to `path`
+    ///
+    /// The snapshot holds the formula plus each member's export-quality
+    /// learned clauses, so a restarted process can resume a long incremental
+    /// session without the re-warming cliff. Call between solves. The format
+    /// is host-byte-order and not portable across architectures.
+    pub fn save_state<P: AsRef<std::path::Path>>(&mut self, path: P) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let path_str = path.as_ref().to_str()
+            .ok_or_else(|| ParkissatError::IoError("Invalid path".to_string()))?;
+
+        let c_path = CString::new(path_str)?;
+
+        let success = unsafe {
+            ffi::parkissat_save_state(self.solver, c_path.as_ptr())
+        };
+
+        if !success {
+            return Err(ParkissatError::IoError(format!("Failed to save state to: {}", path_str)));
+        }
+
+        Ok(())
+    }
+
+    /// Restore a warm-start snapshot written by [`save_state`] into a freshly
+    /// configured solver
+    ///
+    /// [`save_state`]: ParkissatSolver::save_state
+    pub fn load_state<P: AsRef<std::path::Path>>(&mut self, path: P) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let path_str = path.as_ref().to_str()
+            .ok_or_else(|| ParkissatError::IoError("Invalid path".to_string()))?;
+
+        let c_path = CString::new(path_str)?;
+
+        let success = unsafe {
+            ffi::parkissat_load_state(self.solver, c_path.as_ptr())
+        };
+
+        if !success {
+            return Err(ParkissatError::IoError(format!("Failed to load state from: {}", path_str)));
+        }
+
+        // The restored formula brings its own variable count
+        self.variable_count = unsafe {
+            ffi::parkissat_get_variable_count(self.solver)
+        }.max(0) as usize;
+
+        Ok(())
+    }
+
+    /// Enable DRAT proof logging to `path`
+    ///
+    /// Portfolio member 0 becomes the designated proof producer: it logs its
+    /// derivations in ASCII DRAT through in-memory buffers drained to disk by
+    /// a dedicated writer thread, and imports no foreign clauses while
+    /// logging, so the proof stays self-contained. Enable after [`configure`]
+    /// and before the first solve. An UNSAT answer is certified by the proof
+    /// only when [`winner`] reports member 0.
+    ///
+    /// [`configure`]: ParkissatSolver::configure
+    /// [`winner`]: ParkissatSolver::winner
+    pub fn set_proof_file<P: AsRef<std::path::Path>>(&mut self, path: P) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let path_str = path.as_ref().to_str()
+            .ok_or_else(|| ParkissatError::IoError("Invalid path".to_string()))?;
+
+        let c_path = CString::new(path_str)?;
+
+        let success = unsafe {
+            ffi::parkissat_set_proof_file(self.solver, c_path.as_ptr())
+        };
+
+        if !success {
+            return Err(ParkissatError::IoError(format!("Failed to open proof file: {}", path_str)));
+        }
+
+        Ok(())
+    }
+
+    /// Stop DRAT proof logging, flush the buffered proof bytes, and close the
+    /// proof file. Also happens automatically when the solver is dropped.
+    pub fn clear_proof_file(&mut self) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        unsafe {
+            ffi::parkissat_set_proof_file(self.solver, ptr::null());
+        }
+
+        Ok(())
+    }
+
     /// Add a clause to the solver
-    /// 
+    ///
     /// # Arguments
     /// * `literals` - Array of literals (positive for variable, negative for negation)
     pub fn add_clause(&mut self, literals: &[i32]) -> Result<()> {
         if !self.configured {
             return Err(ParkissatError::NotConfigured);
         }
-        
+        self.ensure_no_async_solve()?;
+
         if literals.is_empty() {
             return Err(ParkissatError::InvalidClause("Empty clause".to_string()));
         }
-        
+
         // Validate literals
         for &lit in literals {
             if lit == 0 {
@@ -206,12 +519,107 @@ impl ParkissatSolver {
         Ok(())
     }
     
+    /// Add many clauses in a single FFI call
+    ///
+    /// The clauses are flattened into one literal buffer plus an offset table
+    /// and ingested by the solver in one pass, which is much faster than
+    /// calling `add_clause` per clause when loading large formulas.
+    pub fn add_clauses<C: AsRef<[i32]>>(&mut self, clauses: &[C]) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        if clauses.is_empty() {
+            return Ok(());
+        }
+
+        let total_lits: usize = clauses.iter().map(|c| c.as_ref().len()).sum();
+        let mut flat_lits = Vec::with_capacity(total_lits);
+        let mut offsets = Vec::with_capacity(clauses.len() + 1);
+        offsets.push(0 as c_int);
+
+        for clause in clauses {
+            let clause = clause.as_ref();
+            if clause.is_empty() {
+                return Err(ParkissatError::InvalidClause("Empty clause".to_string()));
+            }
+
+            for &lit in clause {
+                if lit == 0 {
+                    return Err(ParkissatError::InvalidClause("Literal cannot be zero".to_string()));
+                }
+
+                let var = lit.abs() as usize;
+                if var > self.variable_count {
+                    self.variable_count = var;
+                }
+            }
+
+            flat_lits.extend_from_slice(clause);
+            offsets.push(flat_lits.len() as c_int);
+        }
+
+        unsafe {
+            ffi::parkissat_add_clauses(
+                self.solver,
+                flat_lits.as_ptr(),
+                offsets.as_ptr(),
+                clauses.len() as c_int
+            );
+        }
+
+        Ok(())
+    }
+
+    /// Inject a clause while a solve is running
+    ///
+    /// The clause is staged in each portfolio member's lock-free import
+    /// buffer and picked up at the next restart boundary, so it can be
+    /// called concurrently with a solve started by [`solve_async`]. The
+    /// clause must be sound with respect to the formula and may only use
+    /// variables that are already present.
+    ///
+    /// [`solve_async`]: ParkissatSolver::solve_async
+    pub fn add_clause_concurrent(&self, literals: &[i32]) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+
+        if literals.is_empty() {
+            return Err(ParkissatError::InvalidClause("Empty clause".to_string()));
+        }
+
+        for &lit in literals {
+            if lit == 0 {
+                return Err(ParkissatError::InvalidClause("Literal cannot be zero".to_string()));
+            }
+
+            if lit.abs() as usize > self.variable_count {
+                return Err(ParkissatError::InvalidClause(
+                    "Injected clause uses an unknown variable".to_string()
+                ));
+            }
+        }
+
+        unsafe {
+            ffi::parkissat_add_clause_concurrent(
+                self.solver,
+                literals.as_ptr(),
+                literals.len() as c_int
+            );
+        }
+
+        Ok(())
+    }
+
     /// Set the number of variables explicitly
     pub fn set_variable_count(&mut self, count: usize) -> Result<()> {
         if !self.configured {
             return Err(ParkissatError::NotConfigured);
         }
-        
+        self.ensure_no_async_solve()?;
+
         if count == 0 {
             return Err(ParkissatError::InvalidConfiguration(
                 "Variable count must be positive".to_string()
@@ -226,12 +634,79 @@ impl ParkissatSolver {
         Ok(())
     }
     
+    /// Open an activation-literal scope
+    ///
+    /// Clauses added until the matching [`pop`](Self::pop) can be retracted
+    /// together, while learned state in all portfolio members stays warm.
+    /// Scopes nest; one fresh selector variable is allocated per push.
+    /// Returns the new scope depth.
+    pub fn push(&mut self) -> Result<usize> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let depth = unsafe { ffi::parkissat_push(self.solver) };
+        if depth < 0 {
+            return Err(ParkissatError::InternalError("push failed".to_string()));
+        }
+
+        // The selector occupies one variable slot
+        self.variable_count += 1;
+        Ok(depth as usize)
+    }
+
+    /// Retract all clauses added since the matching [`push`](Self::push)
+    ///
+    /// Returns the remaining scope depth.
+    pub fn pop(&mut self) -> Result<usize> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let depth = unsafe { ffi::parkissat_pop(self.solver) };
+        if depth < 0 {
+            return Err(ParkissatError::NoOpenScope);
+        }
+
+        Ok(depth as usize)
+    }
+
+    /// Run the preprocessing pass now instead of at the first solve
+    ///
+    /// Only meaningful when `enable_preprocessing` is set in the
+    /// configuration. Returns the `(variables, clauses)` size of the formula
+    /// the portfolio will actually solve, or `None` if the preprocessor
+    /// refuted the formula outright (subsequent solves return `Unsat`). The
+    /// reduced formula is reused across later assumption queries; models and
+    /// new clauses keep using the original variable numbering.
+    pub fn preprocess(&mut self) -> Result<Option<(usize, usize)>> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let mut vars: c_int = 0;
+        let mut clauses: c_int = 0;
+        let result = unsafe {
+            ffi::parkissat_preprocess(self.solver, &mut vars, &mut clauses)
+        };
+
+        if result == ffi::PARKISSAT_UNSAT {
+            return Ok(None);
+        }
+
+        Ok(Some((vars as usize, clauses as usize)))
+    }
+
     /// Solve the SAT problem
     pub fn solve(&mut self) -> Result<SolverResult> {
         if !self.configured {
             return Err(ParkissatError::NotConfigured);
         }
-        
+        self.ensure_no_async_solve()?;
+
         let result = unsafe {
             ffi::parkissat_solve(self.solver)
         };
@@ -247,7 +722,8 @@ impl ParkissatSolver {
         if !self.configured {
             return Err(ParkissatError::NotConfigured);
         }
-        
+        self.ensure_no_async_solve()?;
+
         // Validate assumptions
         for &lit in assumptions {
             if lit == 0 {
@@ -265,10 +741,126 @@ impl ParkissatSolver {
         
         let solver_result = SolverResult::from(result);
         self.last_result = Some(solver_result);
-        
+
         Ok(solver_result)
     }
-    
+
+    /// Answer many assumption queries over the same formula in one call
+    ///
+    /// The queries are drained by the portfolio members concurrently, one
+    /// query per idle member, so a burst of thousands of small queries pays
+    /// one FFI round-trip instead of one per query. Batch queries answer
+    /// SAT/UNSAT only: no model or failed-assumption set is retained — re-run
+    /// a query of interest through [`solve_with_assumptions`] for those. An
+    /// interrupt or the configured timeout leaves undrained queries
+    /// [`SolverResult::Unknown`].
+    ///
+    /// [`solve_with_assumptions`]: ParkissatSolver::solve_with_assumptions
+    pub fn solve_batch(&mut self, queries: &[&[i32]]) -> Result<Vec<SolverResult>> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+        if queries.is_empty() {
+            return Ok(Vec::new());
+        }
+
+        let mut flat = Vec::new();
+        let mut offsets = Vec::with_capacity(queries.len() + 1);
+        offsets.push(0 as c_int);
+        for query in queries {
+            for &lit in *query {
+                if lit == 0 {
+                    return Err(ParkissatError::InvalidClause("Assumption cannot be zero".to_string()));
+                }
+                flat.push(lit as c_int);
+            }
+            offsets.push(flat.len() as c_int);
+        }
+
+        let mut results = vec![ffi::PARKISSAT_UNKNOWN; queries.len()];
+        unsafe {
+            ffi::parkissat_solve_batch(
+                self.solver,
+                flat.as_ptr(),
+                offsets.as_ptr(),
+                queries.len() as c_int,
+                results.as_mut_ptr()
+            );
+        }
+
+        Ok(results.into_iter().map(SolverResult::from).collect())
+    }
+
+    /// Start a solve without blocking the calling thread
+    ///
+    /// The result is harvested with [`wait`](Self::wait); [`poll`](Self::poll)
+    /// checks for completion without blocking. While the solve is in flight,
+    /// every method that would modify the problem or the portfolio returns
+    /// [`ParkissatError::SolveInProgress`]; use
+    /// [`add_clause_concurrent`](Self::add_clause_concurrent) and
+    /// [`interrupt`](Self::interrupt) to interact with a running solve.
+    pub fn solve_async(&mut self) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        let started = unsafe { ffi::parkissat_solve_async(self.solver) };
+        if !started {
+            return Err(ParkissatError::InternalError(
+                "a solve is already in flight".to_string()
+            ));
+        }
+
+        self.last_result = None;
+        self.async_active = true;
+        Ok(())
+    }
+
+    /// Check whether an asynchronous solve has finished (non-blocking)
+    pub fn poll(&mut self) -> bool {
+        let done = unsafe { ffi::parkissat_poll(self.solver) };
+        if done {
+            // The workers have quiesced, so mutating calls are safe again
+            // even before wait() harvests the result
+            self.async_active = false;
+        }
+        done
+    }
+
+    /// Wait for an asynchronous solve to finish
+    ///
+    /// Blocks for up to `timeout` (forever with `None`). Returns
+    /// `Ok(Some(result))` once the solve has finished and `Ok(None)` if the
+    /// timeout expired first.
+    pub fn wait(&mut self, timeout: Option<Duration>) -> Result<Option<SolverResult>> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+
+        let timeout_ms: c_int = match timeout {
+            Some(t) => t.as_millis().min(c_int::MAX as u128) as c_int,
+            None => -1,
+        };
+
+        unsafe { ffi::parkissat_wait(self.solver, timeout_ms) };
+
+        if !unsafe { ffi::parkissat_poll(self.solver) } {
+            return Ok(None);
+        }
+
+        // The solve can finish between a timed-out wait and the poll above,
+        // in which case the first wait's return value is a stale Unknown.
+        // Once completion is observed, waiting again returns immediately
+        // with the settled result, so take the answer from there instead.
+        let result = unsafe { ffi::parkissat_wait(self.solver, 0) };
+        self.async_active = false;
+        let solver_result = SolverResult::from(result);
+        self.last_result = Some(solver_result);
+        Ok(Some(solver_result))
+    }
+
     /// Get the truth value of a variable in the model (only valid after SAT result)
     pub fn get_model_value(&self, variable: i32) -> Result<bool> {
         if variable <= 0 {
@@ -315,6 +907,61 @@ impl ParkissatSolver {
         }
     }
     
+    /// Get the failed assumptions after an UNSAT result under assumptions
+    ///
+    /// Returns the subset of the assumptions of the last
+    /// [`solve_with_assumptions`](Self::solve_with_assumptions) call that the
+    /// winning solver used to derive the conflict — an over-approximation of
+    /// an UNSAT core over the assumptions. Errors unless the last result was
+    /// `Unsat`.
+    pub fn failed_assumptions(&self) -> Result<Vec<i32>> {
+        match self.last_result {
+            Some(SolverResult::Unsat) => {
+                let count = unsafe {
+                    ffi::parkissat_failed_assumptions(self.solver, ptr::null_mut(), 0)
+                };
+
+                if count <= 0 {
+                    return Ok(Vec::new());
+                }
+
+                let mut failed = vec![0; count as usize];
+                unsafe {
+                    ffi::parkissat_failed_assumptions(self.solver, failed.as_mut_ptr(), count);
+                }
+
+                Ok(failed)
+            }
+            _ => Err(ParkissatError::NoSolution),
+        }
+    }
+
+    /// Borrow the model without copying it (only valid after SAT result)
+    ///
+    /// Slot `v - 1` holds the signed literal for variable `v`. The slice
+    /// borrows solver-owned memory and is invalidated by the next solve,
+    /// which the borrow checker enforces since solving takes `&mut self`.
+    pub fn get_model_ref(&self) -> Result<&[i32]> {
+        match self.last_result {
+            Some(SolverResult::Sat) => {
+                let mut len: c_int = 0;
+                let ptr = unsafe {
+                    ffi::parkissat_get_model_ptr(self.solver, &mut len)
+                };
+
+                if ptr.is_null() || len <= 0 {
+                    return Ok(&[]);
+                }
+
+                Ok(unsafe { std::slice::from_raw_parts(ptr, len as usize) })
+            }
+            Some(SolverResult::Unsat) | Some(SolverResult::Unknown) => {
+                Err(ParkissatError::NoSolution)
+            }
+            None => Err(ParkissatError::NoSolution),
+        }
+    }
+
     /// Get solver statistics
     pub fn get_statistics(&self) -> Result<SolverStatistics> {
         if !self.configured {
@@ -327,7 +974,102 @@ impl ParkissatSolver {
         
         Ok(SolverStatistics::from(stats))
     }
-    
+
+    /// Get a live statistics snapshot for one portfolio member
+    ///
+    /// The snapshot is refreshed roughly ten times per second while a solve
+    /// runs and is read lock-free, so it is cheap to poll for live conflict
+    /// and propagation rates. `thread_idx` must be below the configured
+    /// thread count.
+    pub fn get_thread_statistics(&self, thread_idx: usize) -> Result<SolverStatistics> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+
+        let mut stats = ffi::ParkissatStatistics {
+            propagations: 0,
+            decisions: 0,
+            conflicts: 0,
+            restarts: 0,
+            mem_peak: 0.0,
+        };
+
+        let ok = unsafe {
+            ffi::parkissat_get_thread_statistics(
+                self.solver,
+                thread_idx as c_int,
+                &mut stats
+            )
+        };
+
+        if !ok {
+            return Err(ParkissatError::InvalidConfiguration(
+                format!("Thread index {} out of range", thread_idx)
+            ));
+        }
+
+        Ok(SolverStatistics::from(stats))
+    }
+
+    /// Portfolio layout chosen by the last [`configure`](Self::configure)
+    ///
+    /// Reports the portfolio size that was actually built — after
+    /// auto-detection when `num_threads` was `-1` — plus the physical-core
+    /// and NUMA-node counts it was derived from.
+    pub fn layout(&self) -> Result<PortfolioLayout> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+
+        let mut layout = ffi::ParkissatLayout {
+            num_threads: 0,
+            physical_cores: 0,
+            numa_nodes: 0,
+            auto_selected: false,
+        };
+
+        unsafe {
+            ffi::parkissat_get_layout(self.solver, &mut layout);
+        }
+
+        Ok(PortfolioLayout::from(layout))
+    }
+
+    /// Index of the portfolio member that produced the last answer
+    ///
+    /// Returns `None` if no solve has finished, the last solve was
+    /// interrupted, or the answer was a collective cube-and-conquer UNSAT.
+    pub fn winner(&self) -> Result<Option<usize>> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+
+        let idx = unsafe { ffi::parkissat_get_winner(self.solver) };
+        Ok(if idx < 0 { None } else { Some(idx as usize) })
+    }
+
+    /// Snapshot the wrapper's hot-path instrumentation counters
+    ///
+    /// Key=value lines, histograms as comma-separated log2(nanosecond)
+    /// buckets. Reports `enabled=0` with zeros unless the crate was built
+    /// with the `perf-instrumentation` feature, which compiles the counters
+    /// into the wrapper hot paths.
+    pub fn dump_perf(&self) -> Result<String> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+
+        let mut buf = vec![0u8; 8192];
+        let written = unsafe {
+            ffi::parkissat_dump_perf(self.solver, buf.as_mut_ptr() as *mut std::os::raw::c_char,
+                                     buf.len() as c_int)
+        };
+
+        buf.truncate(written.max(0) as usize);
+        String::from_utf8(buf)
+            .map_err(|e| ParkissatError::InternalError(format!("invalid perf snapshot: {}", e)))
+    }
+
     /// Interrupt the solver
     pub fn interrupt(&mut self) {
         if !self.solver.is_null() {
@@ -345,6 +1087,48 @@ impl ParkissatSolver {
             }
         }
     }
+
+    /// Install an external termination condition, polled by every portfolio
+    /// member at conflict boundaries
+    ///
+    /// Far tighter cancellation granularity than [`interrupt`]: the callback
+    /// returns nonzero to stop the search, and every member then reports
+    /// [`SolverResult::Unknown`]. It is invoked concurrently from all worker
+    /// threads, so it must be thread-safe and cheap (a relaxed atomic load,
+    /// not a lock). The callback survives reconfiguration.
+    ///
+    /// # Safety
+    ///
+    /// `data` must remain valid, and safe to use from any thread, until the
+    /// callback is removed with [`clear_terminate_callback`] or the solver is
+    /// dropped.
+    ///
+    /// [`interrupt`]: ParkissatSolver::interrupt
+    /// [`clear_terminate_callback`]: ParkissatSolver::clear_terminate_callback
+    pub unsafe fn set_terminate_callback(
+        &mut self,
+        callback: unsafe extern "C" fn(data: *mut std::os::raw::c_void) -> c_int,
+        data: *mut std::os::raw::c_void,
+    ) -> Result<()> {
+        if !self.configured {
+            return Err(ParkissatError::NotConfigured);
+        }
+        self.ensure_no_async_solve()?;
+
+        ffi::parkissat_set_terminate_callback(self.solver, Some(callback), data);
+        Ok(())
+    }
+
+    /// Remove a termination callback installed by [`set_terminate_callback`]
+    ///
+    /// [`set_terminate_callback`]: ParkissatSolver::set_terminate_callback
+    pub fn clear_terminate_callback(&mut self) {
+        if !self.solver.is_null() {
+            unsafe {
+                ffi::parkissat_set_terminate_callback(self.solver, None, ptr::null_mut());
+            }
+        }
+    }
     
     /// Get the number of variables
     pub fn variable_count(&self) -> usize {
@@ -1,6 +1,6 @@
 //! Integration tests for ParKissat-RS bindings
 
-use parkissat_sys::{ParkissatSolver, SolverConfig, SolverResult};
+use parkissat_sys::{DiversificationPlan, ParkissatError, ParkissatSolver, PinPolicy, SolveMode, SolverConfig, SolverResult};
 
 #[test]
 fn test_basic_solver_functionality() {
@@ -55,6 +55,76 @@ fn test_solver_statistics() {
     assert!(stats.decisions > 0 || stats.propagations > 0);
 }
 
+#[test]
+fn test_thread_statistics_and_winner() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // Nothing has been solved yet
+    assert_eq!(solver.winner().expect("Failed to query winner"), None);
+
+    solver.add_clause(&[1, 2, 3]).expect("Failed to add clause");
+    solver.add_clause(&[-1, -2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, -3]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    let winner = solver.winner().expect("Failed to query winner");
+    let winner = winner.expect("A finished solve must have a winner");
+    assert!(winner < 2);
+
+    // The winner's snapshot must show activity; out-of-range indices error
+    let stats = solver
+        .get_thread_statistics(winner)
+        .expect("Failed to get thread statistics");
+    assert!(stats.decisions > 0 || stats.propagations > 0);
+    assert!(solver.get_thread_statistics(2).is_err());
+}
+
+#[test]
+fn test_auto_thread_layout() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    // Layout is only known after configure
+    assert!(solver.layout().is_err());
+
+    let config = SolverConfig {
+        num_threads: -1,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    let layout = solver.layout().expect("Failed to query layout");
+    assert!(layout.auto_selected);
+    assert!(layout.num_threads >= 1);
+    assert!(layout.physical_cores >= 1);
+    assert!(layout.numa_nodes >= 1);
+    // Auto never oversubscribes the physical cores
+    assert!(layout.num_threads <= layout.physical_cores);
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    // An explicit thread count is reported verbatim, not auto-selected
+    let mut explicit = ParkissatSolver::new().expect("Failed to create solver");
+    let config = SolverConfig {
+        num_threads: 2,
+        ..SolverConfig::default()
+    };
+    explicit.configure(&config).expect("Failed to configure solver");
+    let layout = explicit.layout().expect("Failed to query layout");
+    assert!(!layout.auto_selected);
+    assert_eq!(layout.num_threads, 2);
+}
+
 #[test]
 fn test_multiple_solutions() {
     let mut solver = ParkissatSolver::new().expect("Failed to create solver");
@@ -77,6 +147,57 @@ fn test_multiple_solutions() {
     assert!(x1_value || x2_value);
 }
 
+#[test]
+fn test_batched_clause_ingestion() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // Same formula as the basic test, loaded through the batched API
+    solver.add_clauses(&[vec![1, 2], vec![-1, 2]]).expect("Failed to add clauses");
+    assert_eq!(solver.variable_count(), 2);
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    let x2_value = solver.get_model_value(2).expect("Failed to get model value");
+    assert!(x2_value);
+}
+
+#[test]
+fn test_batched_zero_literal_rejected() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    let result = solver.add_clauses(&[vec![1, 2], vec![0]]);
+    assert!(result.is_err());
+}
+
+#[test]
+fn test_model_is_variable_indexed() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    solver.set_variable_count(3).expect("Failed to set variable count");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    let model = solver.get_model_ref().expect("Failed to get model slice");
+    assert_eq!(model.len(), 3);
+    for (i, &lit) in model.iter().enumerate() {
+        assert_eq!(lit.unsigned_abs() as usize, i + 1);
+    }
+    assert!(model[1] > 0); // x2 must be true
+}
+
 #[test]
 fn test_solver_with_assumptions() {
     let mut solver = ParkissatSolver::new().expect("Failed to create solver");
@@ -96,6 +217,317 @@ fn test_solver_with_assumptions() {
     assert!(x2_value);
 }
 
+#[test]
+fn test_cube_and_conquer_sat() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        solve_mode: SolveMode::CubeAndConquer,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2, 3]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-2, 3]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    let model = solver.get_model().expect("Failed to get model");
+    assert!(!model.is_empty());
+}
+
+#[test]
+fn test_cube_and_conquer_unsat() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        solve_mode: SolveMode::CubeAndConquer,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // x1 xor chain forced both ways
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[1, -2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, -2]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+}
+
+#[test]
+fn test_adaptive_portfolio_solves() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        enable_adaptive: true,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+}
+
+#[test]
+fn test_pinned_portfolio_solves() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        pin_policy: PinPolicy::Core,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+}
+
+#[test]
+fn test_deterministic_mode_reproduces_model() {
+    let run = || {
+        let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+        let config = SolverConfig {
+            num_threads: 2,
+            enable_deterministic: true,
+            ..SolverConfig::default()
+        };
+        solver.configure(&config).expect("Failed to configure solver");
+
+        solver.add_clause(&[1, 2, 3]).expect("Failed to add clause");
+        solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+        solver.add_clause(&[-2, 3]).expect("Failed to add clause");
+        solver.add_clause(&[-3, -1]).expect("Failed to add clause");
+
+        let result = solver.solve().expect("Failed to solve");
+        assert_eq!(result, SolverResult::Sat);
+        (solver.get_model().expect("Failed to get model"), solver.winner().unwrap())
+    };
+
+    let (model_a, winner_a) = run();
+    let (model_b, winner_b) = run();
+    assert_eq!(model_a, model_b);
+    assert_eq!(winner_a, winner_b);
+}
+
+#[test]
+fn test_push_pop_scopes() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1]).expect("Failed to add clause");
+
+    // Inside the scope the formula is contradictory
+    assert_eq!(solver.push().expect("Failed to push"), 1);
+    solver.add_clause(&[-1]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+
+    // After pop the scoped clause is retracted again
+    assert_eq!(solver.pop().expect("Failed to pop"), 0);
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+}
+
+#[test]
+fn test_pop_without_push() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    assert!(solver.pop().is_err());
+}
+
+#[test]
+fn test_async_solve() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    solver.solve_async().expect("Failed to start async solve");
+
+    let result = solver.wait(None).expect("Failed to wait for solve");
+    assert_eq!(result, Some(SolverResult::Sat));
+    assert!(solver.poll());
+
+    // The harvested result behaves like a synchronous one
+    assert!(solver.get_model_value(2).expect("Failed to get model value"));
+}
+
+#[test]
+fn test_mutation_rejected_while_async_solve_in_flight() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    solver.solve_async().expect("Failed to start async solve");
+
+    // The in-flight guard holds until poll() or wait() observes completion,
+    // even if the solve itself finishes first
+    assert!(matches!(
+        solver.add_clause(&[3]),
+        Err(ParkissatError::SolveInProgress)
+    ));
+    assert!(matches!(solver.reset(), Err(ParkissatError::SolveInProgress)));
+    assert!(matches!(solver.push(), Err(ParkissatError::SolveInProgress)));
+
+    let result = solver.wait(None).expect("Failed to wait for solve");
+    assert_eq!(result, Some(SolverResult::Sat));
+
+    // Completion observed: mutation is allowed again
+    solver.add_clause(&[3]).expect("Failed to add clause after harvest");
+}
+
+#[test]
+fn test_concurrent_clause_injection() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    solver.solve_async().expect("Failed to start async solve");
+
+    // Blocking clause injected mid-solve: picked up at the next restart, or
+    // simply pending if the solve finishes first — either way it must be
+    // sound and must not disturb the in-flight query.
+    solver.add_clause_concurrent(&[-2, 1]).expect("Failed to inject clause");
+
+    let result = solver.wait(None).expect("Failed to wait for solve");
+    assert_eq!(result, Some(SolverResult::Sat));
+}
+
+#[test]
+fn test_concurrent_clause_unknown_variable_rejected() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+
+    assert!(solver.add_clause_concurrent(&[9]).is_err());
+}
+
+#[test]
+fn test_failed_assumptions() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // x1 -> x2, so assuming x1 and ¬x2 together is contradictory; x3 is free
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    let result = solver
+        .solve_with_assumptions(&[1, -2, 3])
+        .expect("Failed to solve with assumptions");
+    assert_eq!(result, SolverResult::Unsat);
+
+    let failed = solver.failed_assumptions().expect("Failed to get failed assumptions");
+    assert!(!failed.is_empty());
+    // The free assumption cannot be part of the conflict
+    assert!(!failed.contains(&3));
+    for lit in failed {
+        assert!(lit == 1 || lit == -2);
+    }
+}
+
+#[test]
+fn test_preprocessing_shrinks_formula() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        enable_preprocessing: true,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // Unit propagation fixes x1 and x2, leaving only the clause over x3/x4
+    solver.add_clause(&[1]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[3, 4]).expect("Failed to add clause");
+
+    let reduced = solver.preprocess().expect("Failed to preprocess");
+    let (vars, clauses) = reduced.expect("Formula must not be refuted");
+    assert!(vars < 4);
+    assert!(clauses < 3);
+
+    // The model is still reported in the original numbering
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+    assert!(solver.get_model_value(1).expect("Failed to get model value"));
+    assert!(solver.get_model_value(2).expect("Failed to get model value"));
+    let x3 = solver.get_model_value(3).unwrap_or(false);
+    let x4 = solver.get_model_value(4).unwrap_or(false);
+    assert!(x3 || x4);
+}
+
+#[test]
+fn test_preprocessing_skipped_by_open_scope() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        enable_preprocessing: true,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // An open scope keeps the simplifier away; the solve must fall back to
+    // the raw formula rather than racing on an empty portfolio
+    assert_eq!(solver.push().expect("Failed to push"), 1);
+    solver.add_clause(&[1]).expect("Failed to add clause");
+    solver.add_clause(&[-1]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+}
+
+#[test]
+fn test_preprocessing_refutes_formula() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        enable_preprocessing: true,
+        ..SolverConfig::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1]).expect("Failed to add clause");
+    solver.add_clause(&[-1]).expect("Failed to add clause");
+
+    assert_eq!(solver.preprocess().expect("Failed to preprocess"), None);
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+}
+
 #[test]
 fn test_configuration_options() {
     let mut solver = ParkissatSolver::new().expect("Failed to create solver");
@@ -106,6 +538,7 @@ fn test_configuration_options() {
         random_seed: 42,
         enable_preprocessing: true,
         verbosity: 1,
+        ..SolverConfig::default()
     };
     
     solver.configure(&config).expect("Failed to configure solver");
@@ -118,6 +551,361 @@ fn test_configuration_options() {
     assert_eq!(result, SolverResult::Sat);
 }
 
+#[test]
+fn test_load_dimacs_feeds_all_solvers() {
+    use std::io::Write;
+
+    let mut file = tempfile::NamedTempFile::new().expect("Failed to create temp file");
+    write!(
+        file,
+        "c simple satisfiable formula\np cnf 3 3\n1 2 0\n-1 3 0\n-2 -3 0\n"
+    )
+    .expect("Failed to write CNF");
+
+    // Two threads so the formula must reach more than the first solver
+    let config = SolverConfig {
+        num_threads: 2,
+        ..SolverConfig::default()
+    };
+
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+    solver.configure(&config).expect("Failed to configure solver");
+    solver.load_dimacs(file.path()).expect("Failed to load DIMACS");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+}
+
+#[test]
+fn test_load_dimacs_empty_clause_is_unsat() {
+    use std::io::Write;
+
+    let mut file = tempfile::NamedTempFile::new().expect("Failed to create temp file");
+    write!(
+        file,
+        "c a bare 0 line is the empty clause: trivially unsatisfiable\np cnf 2 2\n1 2 0\n0\n"
+    )
+    .expect("Failed to write CNF");
+
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+    solver.configure(&SolverConfig::default()).expect("Failed to configure solver");
+    solver.load_dimacs(file.path()).expect("Failed to load DIMACS");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+}
+
+#[test]
+fn test_load_gzip_dimacs() {
+    use std::io::Write;
+
+    let dir = tempfile::tempdir().expect("Failed to create temp dir");
+    let path = dir.path().join("formula.cnf.gz");
+
+    let file = std::fs::File::create(&path).expect("Failed to create gz file");
+    let mut gz = flate2::write::GzEncoder::new(file, flate2::Compression::default());
+    write!(
+        gz,
+        "c gzip-compressed satisfiable formula\np cnf 3 3\n1 2 0\n-1 3 0\n-2 -3 0\n"
+    )
+    .expect("Failed to write CNF");
+    gz.finish().expect("Failed to finish gz stream");
+
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+    solver.configure(&SolverConfig::default()).expect("Failed to configure solver");
+    solver.load_dimacs(&path).expect("Failed to load gzip DIMACS");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+}
+
+#[test]
+fn test_save_and_load_state() {
+    let dir = tempfile::tempdir().expect("Failed to create temp dir");
+    let path = dir.path().join("solver.state");
+
+    let config = SolverConfig::default();
+
+    {
+        let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+        solver.configure(&config).expect("Failed to configure solver");
+
+        solver.add_clause(&[1, 2]).expect("Failed to add clause");
+        solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+        solver.add_clause(&[-2, 3]).expect("Failed to add clause");
+
+        // Solve once so there is learned state worth snapshotting
+        let result = solver.solve().expect("Failed to solve");
+        assert_eq!(result, SolverResult::Sat);
+
+        solver.save_state(&path).expect("Failed to save state");
+    }
+
+    // A fresh process: configure, restore, solve
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+    solver.configure(&config).expect("Failed to configure solver");
+    solver.load_state(&path).expect("Failed to load state");
+    assert_eq!(solver.variable_count(), 3);
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+    assert!(solver.get_model_value(2).expect("Failed to get model value"));
+    assert!(solver.get_model_value(3).expect("Failed to get model value"));
+}
+
+#[test]
+fn test_preset_diversification_portfolio() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    // Four members draw four different presets from the library; the answer
+    // must not depend on which preset finds it first
+    let config = SolverConfig {
+        num_threads: 4,
+        diversification_plan: DiversificationPlan::Presets,
+        ..Default::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-2, 3]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+    assert!(solver.get_model_value(2).expect("Failed to get model value"));
+    assert!(solver.get_model_value(3).expect("Failed to get model value"));
+
+    // An unsatisfiable core is refuted under every preset as well
+    let mut unsat = ParkissatSolver::new().expect("Failed to create solver");
+    unsat.configure(&config).expect("Failed to configure solver");
+    unsat.add_clause(&[1, 2]).expect("Failed to add clause");
+    unsat.add_clause(&[1, -2]).expect("Failed to add clause");
+    unsat.add_clause(&[-1, 2]).expect("Failed to add clause");
+    unsat.add_clause(&[-1, -2]).expect("Failed to add clause");
+    let result = unsat.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+}
+
+#[test]
+fn test_memory_budget_portfolio_solves() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    // A generous budget: nothing should be shed on a tiny formula, and the
+    // enforcement path must not disturb the result
+    let config = SolverConfig {
+        num_threads: 2,
+        memory_budget_mb: 4096,
+        ..Default::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+    assert!(solver.get_model_value(2).expect("Failed to get model value"));
+}
+
+#[test]
+fn test_dump_perf_snapshot() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+    solver.configure(&SolverConfig::default()).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    let _ = solver.solve().expect("Failed to solve");
+
+    // Counters are zero unless built with perf-instrumentation, but the
+    // snapshot shape is the same either way
+    let snapshot = solver.dump_perf().expect("Failed to dump perf counters");
+    assert!(snapshot.starts_with("enabled="));
+    assert!(snapshot.contains("clauses_ingested="));
+    assert!(snapshot.contains("dispatch_wake_ns_log2="));
+}
+
+#[test]
+fn test_reset_reuses_solver_across_formulas() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        ..Default::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // First formula: unsatisfiable
+    solver.add_clause(&[1]).expect("Failed to add clause");
+    solver.add_clause(&[-1]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+
+    // Second, unrelated formula on the same solver: nothing from the first
+    // may leak into it
+    solver.reset().expect("Failed to reset solver");
+    assert_eq!(solver.variable_count(), 0);
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-2]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+    assert!(solver.get_model_value(1).expect("Failed to get model value"));
+    assert!(!solver.get_model_value(2).expect("Failed to get model value"));
+}
+
+#[test]
+fn test_trim_memory_after_solve() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 2,
+        ..Default::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+
+    // Before any solve the members have not imported the formula yet, so
+    // the packed copy must stay
+    assert_eq!(solver.trim_memory().expect("Failed to trim"), 0);
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    // Now every member holds its own copy and the packed one is redundant
+    let freed = solver.trim_memory().expect("Failed to trim");
+    assert!(freed > 0);
+    // A second trim has nothing left to free
+    assert_eq!(solver.trim_memory().expect("Failed to trim"), 0);
+
+    // Incremental additions and further solves still work on the trimmed
+    // solver
+    solver.add_clause(&[-2, 3]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+
+    solver.add_clause(&[-3]).expect("Failed to add clause");
+    solver.add_clause(&[2]).expect("Failed to add clause");
+    solver.add_clause(&[-2, 3]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+
+    // Reconfiguring after a trim drops the partially freed formula instead
+    // of rebuilding members on its post-trim tail; the solver is reusable
+    // with a fresh formula
+    solver.configure(&config).expect("Failed to reconfigure solver");
+    solver.add_clause(&[4]).expect("Failed to add clause");
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+    assert!(solver.get_model_value(4).expect("Failed to get model value"));
+}
+
+#[test]
+fn test_terminate_callback_stops_solve() {
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    static CALLS: AtomicUsize = AtomicUsize::new(0);
+
+    unsafe extern "C" fn stop_now(_data: *mut std::os::raw::c_void) -> std::os::raw::c_int {
+        CALLS.fetch_add(1, Ordering::Relaxed);
+        1
+    }
+
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // Pigeonhole 6-into-5: hard enough that the search cannot finish before
+    // the first conflict boundary polls the callback
+    let pigeons = 6;
+    let holes = 5;
+    let var = |p: i32, h: i32| (p - 1) * holes + h;
+    for p in 1..=pigeons {
+        let clause: Vec<i32> = (1..=holes).map(|h| var(p, h)).collect();
+        solver.add_clause(&clause).expect("Failed to add clause");
+    }
+    for h in 1..=holes {
+        for p1 in 1..=pigeons {
+            for p2 in (p1 + 1)..=pigeons {
+                solver.add_clause(&[-var(p1, h), -var(p2, h)]).expect("Failed to add clause");
+            }
+        }
+    }
+
+    unsafe {
+        solver.set_terminate_callback(stop_now, std::ptr::null_mut())
+            .expect("Failed to set terminate callback");
+    }
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unknown);
+    assert!(CALLS.load(Ordering::Relaxed) > 0);
+
+    // Without the callback the same query finishes
+    solver.clear_terminate_callback();
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+}
+
+#[test]
+fn test_solve_batch_mixed_queries() {
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig {
+        num_threads: 4,
+        ..Default::default()
+    };
+    solver.configure(&config).expect("Failed to configure solver");
+
+    // x1 ∨ x2, so only assuming both false is contradictory
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+
+    let queries: Vec<&[i32]> = vec![&[-1], &[-2], &[-1, -2], &[1, 2]];
+    let results = solver.solve_batch(&queries).expect("Failed to solve batch");
+
+    assert_eq!(results.len(), 4);
+    assert_eq!(results[0], SolverResult::Sat);
+    assert_eq!(results[1], SolverResult::Sat);
+    assert_eq!(results[2], SolverResult::Unsat);
+    assert_eq!(results[3], SolverResult::Sat);
+
+    // The portfolio stays usable for ordinary solves afterwards
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Sat);
+}
+
+#[test]
+fn test_proof_file_written_for_unsat() {
+    let dir = tempfile::tempdir().expect("Failed to create temp dir");
+    let path = dir.path().join("proof.drat");
+
+    let mut solver = ParkissatSolver::new().expect("Failed to create solver");
+
+    let config = SolverConfig::default();
+    solver.configure(&config).expect("Failed to configure solver");
+    solver.set_proof_file(&path).expect("Failed to set proof file");
+
+    // All four clauses over two variables: unsatisfiable, but needs at least
+    // one resolution step, so the proof is non-trivial
+    solver.add_clause(&[1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[1, -2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, 2]).expect("Failed to add clause");
+    solver.add_clause(&[-1, -2]).expect("Failed to add clause");
+
+    let result = solver.solve().expect("Failed to solve");
+    assert_eq!(result, SolverResult::Unsat);
+
+    // With a single member the producer is necessarily the winner, so the
+    // proof certifies the answer
+    assert_eq!(solver.winner().expect("Failed to query winner"), Some(0));
+
+    // Flush and close, then the file must hold the derivation
+    solver.clear_proof_file().expect("Failed to close proof file");
+    let proof = std::fs::read(&path).expect("Failed to read proof file");
+    assert!(!proof.is_empty());
+}
+
 #[test]
 fn test_variable_count_tracking() {
     let mut solver = ParkissatSolver::new().expect("Failed to create solver");
@@ -3,261 +3,2937 @@
 #include "painless-src/solvers/SolverInterface.h"
 #include "painless-src/solvers/SolverFactory.h"
 #include "painless-src/solvers/KissatBonus.h"
+#include "painless-src/clauses/ClauseBuffer.h"
 #include "painless-src/clauses/ClauseExchange.h"
+#include "painless-src/clauses/ClauseManager.h"
 #include "painless-src/utils/Parameters.h"
 #include "painless-src/working/SequentialWorker.h"
 #include "painless-src/working/Portfolio.h"
+#include "painless-src/sharing/HordeSatSharing.h"
+#include "painless-src/sharing/Sharer.h"
+#include "painless-src/sharing/SharingStrategy.h"
+#include "painless-src/simplify/simplify.h"
 
 extern "C" {
     #include "kissat_mab/src/kissat.h"
+    #include "kissat_mab/src/file.h"
 }
 
+// Proof plumbing lives in kissat_mab/src/proof.h, which is not part of the
+// public kissat.h surface; declare the two entry points we need directly.
+extern "C" void kissat_init_proof(kissat*, file*, bool binary);
+extern "C" void kissat_release_proof(kissat*);
+
+// IPASIR-style terminate hook, polled by kissat at conflict boundaries
+extern "C" void kissat_set_terminate(kissat*, void* state, int (*terminate)(void* state));
+
 #include <vector>
 #include <memory>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <string>
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+// painless-src expects these globals to be defined by its main(); since we link
+// the painless objects without painless.cpp, the wrapper hosts them instead.
+std::atomic<bool> globalEnding(false);
+Sharer** sharers = NULL;
+int nSharers = 0;
+WorkingStrategy* working = NULL;
+SatResult finalResult = UNKNOWN;
+std::vector<int> finalModel;
 
 extern "C" {
 
+// Hot-path instrumentation. Compiled in only with -DPARKISSAT_PERF (the
+// crate's perf-instrumentation feature); in the default build kPerfEnabled
+// is a constant false, so every recording site below folds to nothing and
+// the hot paths carry no instrumentation cost at all.
+#ifdef PARKISSAT_PERF
+static constexpr bool kPerfEnabled = true;
+#else
+static constexpr bool kPerfEnabled = false;
+#endif
+
+// Power-of-two histogram: value v lands in bucket floor(log2(v))
+struct PerfHistogram {
+    static const int kBuckets = 32;
+    std::atomic<uint64_t> buckets[kBuckets];
+
+    PerfHistogram() {
+        for (int i = 0; i < kBuckets; i++) {
+            buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(uint64_t v) {
+        int b = 0;
+        while (v > 1 && b < kBuckets - 1) {
+            v >>= 1;
+            b++;
+        }
+        buckets[b].fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// Relaxed atomics: the recording sites run on the hot paths, the reader is
+// parkissat_dump_perf() and tolerates slightly stale values
+struct PerfCounters {
+    std::atomic<uint64_t> clauses_ingested{0};
+    std::atomic<uint64_t> literals_ingested{0};
+    std::atomic<uint64_t> arena_bytes{0};       // arena occupancy, all slabs
+    std::atomic<uint64_t> solves_dispatched{0}; // jobs handed to the pool
+    std::atomic<uint64_t> models_published{0};
+    PerfHistogram dispatch_wake_ns;    // dispatch to first worker wakeup
+    PerfHistogram model_readback_ns;   // publishModel duration
+};
+
+static uint64_t perf_now_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// Bump allocator for the ClauseExchange objects owned by the wrapper. Clauses
+// are packed back to back into large slabs, so loading a formula is sequential
+// writes with no per-clause allocator overhead, and everything is freed en
+// masse. Individual clauses are never returned to the allocator.
+class ClauseArena {
+public:
+    static const size_t kSlabSize = 1 << 22; // 4 MiB of clause payload per slab
+
+    ClauseArena() : perf(nullptr), cursor(nullptr), remaining(0) {}
+
+    // Instrumentation sink; set by the owning solver, may stay null
+    PerfCounters* perf;
+
+    ~ClauseArena() {
+        clear();
+    }
+
+    // Allocate and initialize a clause header; the caller fills in the
+    // literals. Returns nullptr on allocation failure.
+    ClauseExchange* alloc(int size) {
+        size_t footprint = footprintOf(size);
+
+        if (footprint > remaining) {
+            if (!grow(footprint)) {
+                return nullptr;
+            }
+        }
+
+        ClauseExchange* clause = (ClauseExchange*)cursor;
+        cursor += footprint;
+        remaining -= footprint;
+
+        clause->nbRefs.store(1);
+        clause->lbd = 2; // Default LBD value
+        clause->from = 0;
+        clause->size = size;
+
+        if (kPerfEnabled && perf) {
+            perf->clauses_ingested.fetch_add(1, std::memory_order_relaxed);
+            perf->literals_ingested.fetch_add((uint64_t)size, std::memory_order_relaxed);
+            perf->arena_bytes.fetch_add(footprint, std::memory_order_relaxed);
+        }
+
+        clauses.push_back(clause);
+        return clause;
+    }
+
+    // Make sure the next `bytes` of clause payload fit into one slab, so a
+    // whole batch lands in a single allocation.
+    bool reserve(size_t bytes) {
+        if (bytes > remaining) {
+            return grow(bytes);
+        }
+        return true;
+    }
+
+    // Free all slabs at once
+    void clear() {
+        for (auto& slab : slabs) {
+            free(slab.first);
+        }
+        for (auto& slab : spare) {
+            free(slab.first);
+        }
+        slabs.clear();
+        spare.clear();
+        clauses.clear();
+        cursor = nullptr;
+        remaining = 0;
+    }
+
+    // Drop every clause but retire the slabs for recycling, so loading the
+    // next formula of similar size performs no large allocations
+    void reset() {
+        for (auto& slab : slabs) {
+            spare.push_back(slab);
+        }
+        slabs.clear();
+        clauses.clear();
+        cursor = nullptr;
+        remaining = 0;
+    }
+
+    // Return every slab — live and spare — to the system and report how many
+    // bytes that gave back. Unlike reset(), nothing is kept for recycling;
+    // the caller has established that no one holds pointers into the slabs.
+    size_t trim() {
+        size_t bytes = 0;
+        for (auto& slab : slabs) {
+            bytes += slab.second;
+        }
+        for (auto& slab : spare) {
+            bytes += slab.second;
+        }
+        clear();
+        return bytes;
+    }
+
+    static size_t footprintOf(int size) {
+        size_t footprint = sizeof(ClauseExchange) + size * sizeof(int);
+        return (footprint + alignof(ClauseExchange) - 1) & ~(alignof(ClauseExchange) - 1);
+    }
+
+    // Every live clause, in insertion order
+    std::vector<ClauseExchange*> clauses;
+
+private:
+    bool grow(size_t at_least) {
+        // Recycle a retired slab when one is big enough
+        for (size_t i = 0; i < spare.size(); i++) {
+            if (spare[i].second >= at_least) {
+                slabs.push_back(spare[i]);
+                cursor = spare[i].first;
+                remaining = spare[i].second;
+                spare[i] = spare.back();
+                spare.pop_back();
+                return true;
+            }
+        }
+
+        size_t slab_size = at_least > kSlabSize ? at_least : kSlabSize;
+        char* slab = (char*)malloc(slab_size);
+        if (!slab) {
+            return false;
+        }
+        slabs.push_back(std::make_pair(slab, slab_size));
+        cursor = slab;
+        remaining = slab_size;
+        return true;
+    }
+
+    std::vector<std::pair<char*, size_t>> slabs;  // slabs the clauses live in
+    std::vector<std::pair<char*, size_t>> spare;  // retired by reset(), reusable
+    char* cursor;
+    size_t remaining;
+};
+
+// Read-only shared store for the original formula. The clauses live exactly
+// once, packed in the arena; every portfolio member receives pointers into
+// that single copy through the ClauseExchange layer (solver-internal watch
+// and import structures are still per member). The store remembers how many
+// clauses each member has been fed, so incremental additions only hand out
+// the tail and a freshly created member can be reseeded from clause zero.
+class SharedClauseStore {
+public:
+    ClauseArena arena;
+
+    SharedClauseStore() : base(0), num_members(0) {}
+
+    // (Re)bind the store to a portfolio of the given size; all members count
+    // as having seen nothing yet.
+    void attach(size_t num_solvers) {
+        fed.assign(num_solvers, base);
+        imported.reset(new std::atomic<size_t>[num_solvers]);
+        for (size_t i = 0; i < num_solvers; i++) {
+            imported[i].store(base, std::memory_order_relaxed);
+        }
+        num_members = num_solvers;
+    }
+
+    // Hand every member the clauses it has not seen yet
+    void distribute(const std::vector<SolverInterface*>& solvers) {
+        for (size_t i = 0; i < solvers.size() && i < fed.size(); i++) {
+            for (size_t c = fed[i] - base; c < arena.clauses.size(); c++) {
+                solvers[i]->addClause(arena.clauses[c]);
+            }
+            fed[i] = base + arena.clauses.size();
+        }
+    }
+
+    // Feed the whole formula to one member, e.g. after it was recreated.
+    // Only valid while the packed copy is complete (canReseed()).
+    void reseed(SolverInterface* s, size_t idx) {
+        for (auto* clause : arena.clauses) {
+            s->addClause(clause);
+        }
+        if (idx < fed.size()) {
+            fed[idx] = base + arena.clauses.size();
+        }
+        if (idx < num_members) {
+            imported[idx].store(base, std::memory_order_relaxed);
+        }
+    }
+
+    // Called from a member's worker thread after its solve() returns: every
+    // clause handed out before that solve now lives in the member's own
+    // database, so the packed copy is no longer needed on its behalf.
+    void markImported(size_t idx) {
+        if (idx < num_members) {
+            imported[idx].store(fed[idx], std::memory_order_relaxed);
+        }
+    }
+
+    size_t numClauses() const {
+        return base + arena.clauses.size();
+    }
+
+    // True while the packed copy still covers the whole formula, i.e. a
+    // freshly created member can be fed from clause zero
+    bool canReseed() const {
+        return base == 0;
+    }
+
+    // Free the packed copy once every member has imported every clause into
+    // its own database; returns the bytes given back, or 0 when some member
+    // still depends on the arena. Afterwards canReseed() is false until the
+    // next reset().
+    size_t trim() {
+        size_t total = numClauses();
+        for (size_t i = 0; i < num_members; i++) {
+            if (imported[i].load(std::memory_order_relaxed) < total) {
+                return 0;
+            }
+        }
+        base = total;
+        return arena.trim();
+    }
+
+    // Drop the formula but keep the arena slabs for recycling; every member
+    // counts as having seen nothing again
+    void reset() {
+        base = 0;
+        arena.reset();
+        fed.assign(fed.size(), 0);
+        for (size_t i = 0; i < num_members; i++) {
+            imported[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::vector<size_t> fed;  // per member: clauses already handed out
+    size_t base;              // clauses trimmed away but still counted as seen
+    size_t num_members;       // size of the imported[] array
+    std::unique_ptr<std::atomic<size_t>[]> imported; // per member: clauses in its own DB
+};
+
+// Online CPUs grouped by NUMA node, as reported by sysfs
+struct NumaTopology {
+    std::vector<std::vector<int>> node_cpus;
+};
+
+// Parse a sysfs cpulist like "0-15,64-79"
+static void parse_cpu_list(const char* text, std::vector<int>* cpus) {
+    const char* p = text;
+    while (*p) {
+        if (*p < '0' || *p > '9') {
+            p++;
+            continue;
+        }
+        int first = (int)strtol(p, (char**)&p, 10);
+        int last = first;
+        if (*p == '-') {
+            p++;
+            last = (int)strtol(p, (char**)&p, 10);
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus->push_back(cpu);
+        }
+    }
+}
+
+static NumaTopology detect_numa_topology() {
+    NumaTopology topo;
+
+    for (int node = 0; node < 256; node++) {
+        char path[128];
+        snprintf(path, sizeof path, "/sys/devices/system/node/node%d/cpulist", node);
+        FILE* f = fopen(path, "r");
+        if (!f) {
+            break;
+        }
+        char line[4096];
+        std::vector<int> cpus;
+        if (fgets(line, sizeof line, f)) {
+            parse_cpu_list(line, &cpus);
+        }
+        fclose(f);
+        if (!cpus.empty()) {
+            topo.node_cpus.push_back(cpus);
+        }
+    }
+
+    // No NUMA information: one flat node over all online CPUs
+    if (topo.node_cpus.empty()) {
+        std::vector<int> cpus;
+        int n = (int)std::thread::hardware_concurrency();
+        for (int cpu = 0; cpu < n; cpu++) {
+            cpus.push_back(cpu);
+        }
+        topo.node_cpus.push_back(cpus);
+    }
+
+    return topo;
+}
+
+// Count physical cores via sysfs: hyperthread siblings share one
+// thread_siblings_list, so exactly one CPU per core is first in its own list.
+static int count_physical_cores() {
+    int logical = (int)std::thread::hardware_concurrency();
+    int cores = 0;
+    for (int cpu = 0; cpu < logical; cpu++) {
+        char path[128];
+        snprintf(path, sizeof path,
+                 "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+        FILE* f = fopen(path, "r");
+        if (!f) {
+            // No sysfs topology: treat every logical CPU as a core
+            return logical > 0 ? logical : 1;
+        }
+        char line[256];
+        std::vector<int> siblings;
+        if (fgets(line, sizeof line, f)) {
+            parse_cpu_list(line, &siblings);
+        }
+        fclose(f);
+        if (!siblings.empty() && siblings[0] == cpu) {
+            cores++;
+        }
+    }
+    return cores > 0 ? cores : 1;
+}
+
+// MemAvailable from /proc/meminfo, in MiB (0 when unknown)
+static long available_memory_mb() {
+    FILE* f = fopen("/proc/meminfo", "r");
+    if (!f) {
+        return 0;
+    }
+    char line[256];
+    long kb = 0;
+    while (fgets(line, sizeof line, f)) {
+        if (sscanf(line, "MemAvailable: %ld kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(f);
+    return kb / 1024;
+}
+
+// One cache line of relaxed atomics per portfolio member. The sampler thread
+// refreshes these during a solve and each worker refreshes its own slot at
+// job boundaries; readers get a wait-free, slightly stale snapshot without
+// touching the solver itself.
+struct alignas(64) ThreadStatsSnapshot {
+    std::atomic<uint64_t> propagations;
+    std::atomic<uint64_t> decisions;
+    std::atomic<uint64_t> conflicts;
+    std::atomic<uint64_t> restarts;
+    std::atomic<double> mem_peak;
+
+    ThreadStatsSnapshot()
+        : propagations(0), decisions(0), conflicts(0), restarts(0), mem_peak(0.0) {}
+};
+
 struct ParkissatSolver {
     std::vector<SolverInterface*> solvers;
-    std::vector<ClauseExchange*> clauses;
+    SharedClauseStore store;
     std::vector<int> model;
     ParkissatResult last_result;
     int num_variables;
-    bool interrupted;
+    // Set by parkissat_interrupt() from arbitrary threads and read in the
+    // worker loops, so it must be atomic like deadline_fired
+    std::atomic<bool> interrupted;
     ParkissatConfig config;
-    
-    ParkissatSolver() : last_result(PARKISSAT_UNKNOWN), num_variables(0), interrupted(false) {
+    ParkissatLayout layout; // portfolio size chosen at configure, and why
+
+    // Preprocessing state. When enable_preprocessing is set, ingested clauses
+    // stay in the store until the painless simplifier has run once over the
+    // whole formula — at parkissat_preprocess() or lazily at the first solve —
+    // and the portfolio then works on the reduced formula. pre_mapto/pre_mapval
+    // translate between the caller's variable numbering and the reduced one.
+    bool preprocessed;
+    bool pre_unsat;               // the simplifier refuted the formula outright
+    bool pre_abandoned;           // raw formula handed out, simplifier stands down
+    int orig_variables;           // variable count in the caller's numbering
+    std::vector<int> pre_mapto;   // orig var -> signed reduced literal (0 = absent)
+    std::vector<int> pre_mapval;  // orig var -> fixed value +1/-1 (0 = free)
+
+    // While preprocessing is pending, the store must not hand anything out
+    bool deferDistribution() const {
+        return config.enable_preprocessing && !preprocessed && !pre_abandoned;
+    }
+
+    // Preprocessing could not run at solve time (an open push scope blocks
+    // the simplifier): hand the members the raw formula and stop deferring,
+    // so a solve never dispatches a portfolio that was fed nothing. The
+    // simplifier stands down for this formula — the members already hold
+    // the raw clauses.
+    void distributeRawFallback() {
+        if (!deferDistribution() || store.numClauses() == 0) {
+            return;
+        }
+        pre_abandoned = true;
+        store.distribute(solvers);
+    }
+
+    // Translate one caller literal into the reduced space. Returns +1 if the
+    // literal is fixed true (clause satisfied, assumption trivial), -1 if it
+    // is fixed false (drop it from a clause, an assumption conflicts), and 0
+    // with *out holding the reduced literal otherwise. Variables the
+    // preprocessor never saw get a fresh slot above the reduced count.
+    int mapLiteral(int lit, int* out) {
+        if (!preprocessed) {
+            *out = lit;
+            return 0;
+        }
+
+        int var = abs(lit);
+        if ((size_t)var >= pre_mapto.size()) {
+            pre_mapto.resize(var + 1, 0);
+            pre_mapval.resize(var + 1, 0);
+        }
+        if (var > orig_variables) {
+            orig_variables = var;
+        }
+
+        if (pre_mapval[var] != 0) {
+            return ((lit > 0) == (pre_mapval[var] > 0)) ? 1 : -1;
+        }
+        if (pre_mapto[var] == 0) {
+            pre_mapto[var] = ++num_variables;
+        }
+
+        int mapped = pre_mapto[var];
+        *out = lit > 0 ? mapped : -mapped;
+        return 0;
+    }
+
+    // Activation literals for the open push/pop scopes, innermost last. A
+    // clause added inside a scope carries the negation of the innermost
+    // selector; every solve assumes all selectors, and pop adds the selector's
+    // negation as a unit clause, permanently satisfying the scope's clauses.
+    std::vector<int> scope_selectors;
+
+    // Clause sharing machinery, alive only while a sharing-enabled solve runs
+    SharingStrategy* sharing_strategy;
+    Sharer* sharer;
+
+    // DRAT proof emission. Member 0 is the designated proof producer: its
+    // kissat instance logs DRAT through a large stdio buffer into an enlarged
+    // pipe that a dedicated writer thread drains to disk, so the solver hot
+    // loop never blocks on file I/O. To keep the proof self-contained, member
+    // 0 imports no foreign clauses while logging is active — so an UNSAT
+    // answer is certified only when member 0 is the winner.
+    bool proof_active;
+    std::string proof_path;
+    file proof_file;
+    FILE* proof_sink;                  // pipe write end handed to kissat
+    std::vector<char> proof_sink_buf;  // stdio buffer backing proof_sink
+    int proof_read_fd;
+    std::thread proof_writer;
+
+    // True when member idx must not receive clauses other members derived
+    bool excludeFromImports(size_t idx) const {
+        return proof_active && idx == 0;
+    }
+
+    // External termination condition, polled by every member's kissat
+    // instance at conflict boundaries. Stored here so reconfiguration and
+    // adaptive relaunches re-wire the hook onto fresh instances.
+    int (*terminate_cb)(void*);
+    void* terminate_data;
+
+    void wireTerminateCallback(SolverInterface* s) {
+        kissat_set_terminate(((KissatBonus*)s)->solver, terminate_data, terminate_cb);
+    }
+
+    // Persistent worker pool: one thread per solver, created once in
+    // parkissat_configure() and parked on pool_cv between solve calls, so an
+    // incremental workload pays no thread create/join cost per query and each
+    // solver stays on the thread (and caches) it warmed up.
+    std::vector<std::thread> workers;
+    std::mutex pool_mutex;
+    std::condition_variable pool_cv;   // wakes workers for a new job
+    std::condition_variable done_cv;   // wakes the caller when a job finishes
+    std::vector<cpu_set_t> worker_cpusets; // per worker, empty when unpinned
+    uint64_t job_generation;
+    size_t workers_remaining;
+    bool pool_shutdown;
+    const std::vector<int>* job_cube;
+    std::atomic<bool> solved;
+    std::atomic<SatResult> job_result;
+
+    // Clauses injected mid-solve through parkissat_add_clause_concurrent().
+    // These are individually refcounted (ClauseManager) rather than
+    // arena-resident; the lock-free buffer doubles as the multi-producer-safe
+    // registry that the destructor drains to release them.
+    ClauseBuffer injected_clauses;
+
+    // Conflict analysis of the winning solver after an UNSAT-under-assumptions
+    // result (raw), and the subset of the caller's assumptions derived from it
+    std::vector<int> final_analysis;
+    std::vector<int> failed_assumptions;
+
+    // Deterministic-mode epoch machinery. Every member solves under the same
+    // fixed conflict budget, then meets the others at the barrier; the last
+    // arriver resolves the epoch under det_mutex — deterministic winner
+    // selection first (lowest finished member index), an ordered synchronous
+    // clause exchange otherwise — before the barrier releases everyone into
+    // the next epoch.
+    std::mutex det_mutex;
+    std::condition_variable det_cv;
+    size_t det_arrived;
+    uint64_t det_epoch_gen;
+    bool det_done;
+    std::vector<SatResult> det_results;
+    uint64_t det_budget;
+    std::atomic<bool> deadline_fired;
+
+    // Cube-and-conquer state: workers drain `cubes` through the atomic
+    // cursor, so idle workers steal the remaining cubes automatically
+    enum JobKind { JOB_PORTFOLIO, JOB_CUBES, JOB_DETERMINISTIC, JOB_BATCH };
+    JobKind job_kind;
+    std::vector<std::vector<int>> cubes;
+    std::atomic<size_t> next_cube;
+    std::atomic<size_t> unsat_cubes;
+
+    // Batched assumption queries: workers drain batch_queries through the
+    // shared cursor, one query per idle member. Queries are independent, so
+    // there is no winner; each slot of batch_results stands on its own.
+    std::vector<std::vector<int>> batch_queries;
+    std::vector<ParkissatResult> batch_results;
+    std::atomic<size_t> next_query;
+
+    // Live per-member statistics and the member that produced the final
+    // answer (-1 while unknown; stays -1 for a cube-and-conquer UNSAT, where
+    // the refutation is collective). The snapshot array is sized with the
+    // portfolio in parkissat_configure().
+    std::unique_ptr<ThreadStatsSnapshot[]> thread_stats;
+    size_t num_thread_stats;
+    std::atomic<int> winner_idx;
+
+    // Sampler thread keeping the snapshots fresh while a solve runs
+    std::thread stats_thread;
+    std::mutex stats_mutex;
+    std::condition_variable stats_cv;
+    bool stats_shutdown;
+
+    // Adaptive portfolio management. The sampler doubles as the monitor and
+    // flags the slowest member for relaunch; the member's own (possibly
+    // pinned) worker then swaps in a freshly diversified instance reseeded
+    // from the warm store. Retired instances stay alive until the job ends,
+    // because the Sharer and the other workers may still hold their pointers.
+    std::unique_ptr<std::atomic<bool>[]> relaunch_flags;
+    // Memory budget enforcement: a flagged member swaps in a fresh
+    // formula-only instance (dropping its learned-clause memory) and its
+    // worker sits out the rest of the race. The flag stays up until the
+    // next race so the sampler never sheds the same slot twice.
+    std::unique_ptr<std::atomic<bool>[]> shed_flags;
+    std::vector<int> relaunch_gen;
+    std::vector<uint64_t> adaptive_last_conflicts;
+    int adaptive_ticks;
+    std::atomic<bool> job_active;
+    std::vector<SolverInterface*> retired_solvers;
+    std::mutex retired_mutex;
+
+    // Guards replacement of solvers[] slots. Relaunch and shed swap a slot
+    // from the member's own worker thread while other threads read it: the
+    // winner's interrupt loop, the deadline watchdog, the stats sampler,
+    // user interrupts, and concurrent clause injection. Those readers take
+    // a snapshot under the lock; the retired list keeps the old instance
+    // alive until race end, so using a snapshot after unlocking is safe,
+    // and the lock ordering gives the reader a fully constructed instance.
+    // parkissat_reset() releases old instances inline instead of retiring
+    // them, so the stats sampler — the only reader running between solves —
+    // holds the lock across its whole use, not just the snapshot.
+    std::mutex member_mutex;
+
+    SolverInterface* memberSnapshot(size_t idx) {
+        std::lock_guard<std::mutex> lock(member_mutex);
+        return solvers[idx];
+    }
+
+    // Deadline watchdog enforcing config.timeout_seconds, armed per solve
+    std::thread deadline_thread;
+    std::mutex deadline_mutex;
+    std::condition_variable deadline_cv;
+    bool deadline_cancel;
+
+    // Hot-path counters; dead weight unless built with PARKISSAT_PERF
+    PerfCounters perf;
+    std::atomic<uint64_t> perf_dispatch_ns;
+
+    // Stamp a pool dispatch so the first worker to wake can record the
+    // wakeup latency
+    void perfMarkDispatch() {
+        if (!kPerfEnabled) {
+            return;
+        }
+        perf.solves_dispatched.fetch_add(1, std::memory_order_relaxed);
+        perf_dispatch_ns.store(perf_now_ns(), std::memory_order_relaxed);
+    }
+
+    // Asynchronous solve coordination
+    std::thread async_thread;
+    std::atomic<bool> async_running;
+    std::atomic<bool> async_done;
+    std::mutex async_mutex;
+    std::condition_variable async_cv;
+
+    ParkissatSolver() : last_result(PARKISSAT_UNKNOWN), num_variables(0), interrupted(false),
+                        preprocessed(false), pre_unsat(false), pre_abandoned(false),
+                        orig_variables(0),
+                        sharing_strategy(nullptr), sharer(nullptr),
+                        proof_active(false), proof_sink(nullptr), proof_read_fd(-1),
+                        terminate_cb(nullptr), terminate_data(nullptr),
+                        job_generation(0), workers_remaining(0), pool_shutdown(false),
+                        job_cube(nullptr), solved(false), job_result(UNKNOWN),
+                        det_arrived(0), det_epoch_gen(0), det_done(false), det_budget(0),
+                        deadline_fired(false),
+                        job_kind(JOB_PORTFOLIO), next_cube(0), unsat_cubes(0),
+                        next_query(0),
+                        num_thread_stats(0), winner_idx(-1), stats_shutdown(false),
+                        adaptive_ticks(0), job_active(false),
+                        perf_dispatch_ns(0),
+                        deadline_cancel(false), async_running(false), async_done(false) {
+        store.arena.perf = &perf;
+        layout = ParkissatLayout();
+
         // Initialize default config
         config.num_threads = 1;
         config.timeout_seconds = 0;
         config.random_seed = 0;
         config.enable_preprocessing = false;
         config.verbosity = 0;
+        config.solve_mode = PARKISSAT_MODE_PORTFOLIO;
+        config.cube_split_depth = 0;
+        config.pin_policy = PARKISSAT_PIN_NONE;
+        config.diversification_plan = PARKISSAT_DIV_SEED_ONLY;
+        config.enable_deterministic = false;
+        config.deterministic_conflict_budget = 0;
+        config.enable_adaptive = false;
+        config.memory_budget_mb = 0;
+        config.enable_clause_sharing = false;
+        config.sharing_lbd_limit = 0;
+        config.sharing_lit_budget = 0;
+        config.sharing_interval_us = 0;
     }
-    
-    ~ParkissatSolver() {
-        // Clean up clauses
-        for (auto* clause : clauses) {
-            delete[] clause;
+
+    // Library of complementary parameter blocks for preset diversification
+    // and relaunching. Preset 0 is the baseline every member gets under the
+    // seed-only plan; the others vary restart behaviour (stable vs focused),
+    // phase handling, local search, and clause tiers, so members dealt
+    // different presets follow genuinely different search trajectories.
+    static const int kNumDivPresets = 8;
+
+    parameter divPreset(int k) {
+        parameter p;
+        p.tier1 = 2;
+        p.chrono = 1;
+        p.stable = 1;
+        p.walkinitially = 0;
+        p.target = 1;
+        p.phase = 1;
+        p.heuristic = 1;
+        p.margin = 0;
+        p.ccanr = 1;
+        p.targetinc = 1;
+
+        switch (k % kNumDivPresets) {
+            case 0: break;                                     // baseline
+            case 1: p.stable = 0; p.chrono = 0; break;         // focused, no chrono
+            case 2: p.walkinitially = 1; break;                // walk-seeded phases
+            case 3: p.tier1 = 3; p.target = 2; break;          // heavier tiers
+            case 4: p.phase = 0; p.heuristic = 0; break;       // flipped polarity
+            case 5: p.ccanr = 0; p.targetinc = 0; break;       // no local search, flat targets
+            case 6: p.stable = 0; p.walkinitially = 1; p.phase = 0; break; // focused walker
+            case 7: p.tier1 = 3; p.chrono = 0; p.margin = 1; break;        // wide tiers, strict order
         }
-        
-        // Clean up solvers
-        for (auto* solver : solvers) {
-            solver->release();
+        return p;
+    }
+
+    // Create and diversify one portfolio member under the current config;
+    // parkissat_configure() and parkissat_reset() build members through this
+    // so both produce identical portfolios. Under the preset plan the
+    // library is dealt round-robin on top of the per-member seed.
+    SolverInterface* createMember(int i) {
+        SolverInterface* s = SolverFactory::createKissatBonusSolver();
+        if (!s) {
+            return nullptr;
+        }
+
+        if (config.diversification_plan == PARKISSAT_DIV_PRESETS) {
+            s->setParameter(divPreset(i));
+        } else {
+            s->setParameter(divPreset(0));
+        }
+
+        if (config.random_seed != 0) {
+            s->diversify(i + config.random_seed);
+        } else {
+            s->diversify(i);
+        }
+
+        // A callback installed before reconfiguration carries over
+        if (terminate_cb) {
+            wireTerminateCallback(s);
         }
+        return s;
+    }
+
+    // Stand up the painless Sharer thread around the portfolio. Every solver is
+    // both a producer and a consumer of learned clauses.
+    void startSharing() {
+        if (!config.enable_clause_sharing || solvers.size() < 2) {
+            return;
+        }
+
+        // The proof producer exports but must not consume: imported clauses
+        // would appear in its derivations without a justifying proof step
+        std::vector<SolverInterface*> consumers = solvers;
+        if (proof_active) {
+            consumers.erase(consumers.begin());
+        }
+
+        sharing_strategy = new HordeSatSharing();
+        sharer = new Sharer(0, sharing_strategy, solvers, consumers);
+    }
+
+    // Tear the Sharer down after the portfolio has finished. The Sharer thread
+    // exits when globalEnding flips to true; its destructor joins it.
+    void stopSharing() {
+        if (!sharer) {
+            return;
+        }
+
+        globalEnding = true;
+        delete sharer;
+        sharer = nullptr;
+        delete sharing_strategy;
+        sharing_strategy = nullptr;
+    }
+
+    // Start DRAT logging on member 0. The kissat instance writes through a
+    // fully buffered FILE* into a pipe grown to 1 MiB, and the writer thread
+    // copies the pipe to the target file in 1 MiB chunks — the solver only
+    // stalls if it outruns both the pipe and the disk for a full megabyte.
+    bool startProof(const char* path) {
+        if (solvers.empty()) {
+            return false;
+        }
+
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return false;
+        }
+#ifdef F_SETPIPE_SZ
+        fcntl(fds[1], F_SETPIPE_SZ, 1 << 20);
+#endif
+
+        FILE* out = fopen(path, "wb");
+        if (!out) {
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+
+        proof_sink = fdopen(fds[1], "w");
+        if (!proof_sink) {
+            fclose(out);
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        proof_sink_buf.assign(1 << 20, 0);
+        setvbuf(proof_sink, proof_sink_buf.data(), _IOFBF, proof_sink_buf.size());
+        proof_read_fd = fds[0];
+
+        proof_writer = std::thread([this, out] {
+            std::vector<char> buf(1 << 20);
+            ssize_t n;
+            while ((n = read(proof_read_fd, buf.data(), buf.size())) > 0) {
+                fwrite(buf.data(), 1, (size_t)n, out);
+            }
+            fclose(out);
+            close(proof_read_fd);
+        });
+
+        proof_path = path;
+        proof_file.file = proof_sink;
+        proof_file.close = false;
+        proof_file.reading = false;
+        proof_file.compressed = false;
+        proof_file.path = proof_path.c_str();
+        proof_file.bytes = 0;
+
+        kissat_init_proof(((KissatBonus*)solvers[0])->solver, &proof_file, false);
+        proof_active = true;
+        return true;
+    }
+
+    // Detach the proof from member 0, flush the staged bytes, and wait for
+    // the writer to finish the file. Closing the pipe's write end is what
+    // signals EOF to the writer.
+    void stopProof() {
+        if (!proof_active) {
+            return;
+        }
+
+        kissat_release_proof(((KissatBonus*)solvers[0])->solver);
+        fclose(proof_sink);
+        proof_sink = nullptr;
+        proof_writer.join();
+        proof_active = false;
+    }
+
+    // Arm a monotonic-clock deadline for the current solve. When the budget
+    // expires before disarmDeadline() is called, every portfolio member is
+    // interrupted and the solve returns PARKISSAT_UNKNOWN.
+    void armDeadline() {
+        deadline_fired.store(false);
+        if (config.timeout_seconds <= 0) {
+            return;
+        }
+
+        deadline_cancel = false;
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::seconds(config.timeout_seconds);
+
+        deadline_thread = std::thread([this, deadline] {
+            std::unique_lock<std::mutex> lock(deadline_mutex);
+            bool cancelled = deadline_cv.wait_until(lock, deadline,
+                                                    [this] { return deadline_cancel; });
+            if (cancelled) {
+                return;
+            }
+
+            deadline_fired.store(true);
+            for (size_t i = 0; i < solvers.size(); i++) {
+                memberSnapshot(i)->setSolverInterrupt();
+            }
+        });
+    }
+
+    void disarmDeadline() {
+        if (!deadline_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(deadline_mutex);
+            deadline_cancel = true;
+        }
+        deadline_cv.notify_all();
+        deadline_thread.join();
+    }
+
+    // Map workers onto the machine according to the pin policy. Workers are
+    // dealt across NUMA nodes round-robin so memory bandwidth is balanced,
+    // then onto distinct cores within their node. kissat allocates its clause
+    // database lazily from the solving thread, so once workers are pinned,
+    // first touch places every member's hot structures on its own node; the
+    // shared ClauseExchange blocks are only read once at import and stay
+    // cold afterwards.
+    void computeWorkerAffinity() {
+        worker_cpusets.clear();
+        if (config.pin_policy == PARKISSAT_PIN_NONE) {
+            return;
+        }
+
+        NumaTopology topo = detect_numa_topology();
+        size_t nnodes = topo.node_cpus.size();
+        std::vector<size_t> next_cpu(nnodes, 0);
+
+        for (size_t i = 0; i < solvers.size(); i++) {
+            size_t node = i % nnodes;
+            const std::vector<int>& cpus = topo.node_cpus[node];
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (config.pin_policy == PARKISSAT_PIN_NODE) {
+                for (int cpu : cpus) {
+                    CPU_SET(cpu, &set);
+                }
+            } else {
+                CPU_SET(cpus[next_cpu[node] % cpus.size()], &set);
+                next_cpu[node]++;
+            }
+            worker_cpusets.push_back(set);
+        }
+    }
+
+    // Spawn one worker per solver; workers park until runPortfolio() posts a
+    // job. Only used for portfolios of more than one solver.
+    void startPool() {
+        computeWorkerAffinity();
+        pool_shutdown = false;
+        for (size_t i = 0; i < solvers.size(); i++) {
+            workers.emplace_back(&ParkissatSolver::workerLoop, this, i);
+        }
+    }
+
+    void shutdownPool() {
+        if (workers.empty()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            pool_shutdown = true;
+        }
+        pool_cv.notify_all();
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+        pool_shutdown = false;
+    }
+
+    // Copy one member's counters into its snapshot slot with relaxed stores.
+    // getStatistics() only copies word-sized counters, so calling it from the
+    // sampler while the member is searching is a benign race: a reader may
+    // see a snapshot that mixes counters from slightly different moments, but
+    // never a torn value.
+    void refreshThreadStats(size_t idx) {
+        if (idx >= num_thread_stats) {
+            return;
+        }
+
+        // Hold the member lock across the read, not just for the snapshot:
+        // unlike the interrupt-path readers, the sampler can race
+        // parkissat_reset(), which releases the old instance right after
+        // swapping a slot — a pointer alone would dangle. getStatistics()
+        // only copies counters, so the hold is short.
+        SolvingStatistics st;
+        {
+            std::lock_guard<std::mutex> lock(member_mutex);
+            st = solvers[idx]->getStatistics();
+        }
+        ThreadStatsSnapshot& slot = thread_stats[idx];
+        slot.propagations.store(st.propagations, std::memory_order_relaxed);
+        slot.decisions.store(st.decisions, std::memory_order_relaxed);
+        slot.conflicts.store(st.conflicts, std::memory_order_relaxed);
+        slot.restarts.store(st.restarts, std::memory_order_relaxed);
+        slot.mem_peak.store(st.memPeak, std::memory_order_relaxed);
+    }
+
+    // (Re)size the snapshot array for the current portfolio and start the
+    // sampler that refreshes every slot about ten times per second.
+    void startStatsSampler() {
+        num_thread_stats = solvers.size();
+        thread_stats.reset(new ThreadStatsSnapshot[num_thread_stats]);
+        winner_idx.store(-1);
+
+        relaunch_flags.reset(new std::atomic<bool>[num_thread_stats]);
+        shed_flags.reset(new std::atomic<bool>[num_thread_stats]);
+        for (size_t i = 0; i < num_thread_stats; i++) {
+            relaunch_flags[i].store(false);
+            shed_flags[i].store(false);
+        }
+        relaunch_gen.assign(num_thread_stats, 0);
+        adaptive_last_conflicts.assign(num_thread_stats, 0);
+        adaptive_ticks = 0;
+
+        stats_shutdown = false;
+        stats_thread = std::thread([this] {
+            std::unique_lock<std::mutex> lock(stats_mutex);
+            while (!stats_shutdown) {
+                stats_cv.wait_for(lock, std::chrono::milliseconds(100));
+                if (stats_shutdown) {
+                    return;
+                }
+                lock.unlock();
+                for (size_t i = 0; i < num_thread_stats; i++) {
+                    refreshThreadStats(i);
+                }
+                if (config.enable_adaptive && job_active.load()) {
+                    maybeRelaunchSlowest();
+                }
+                if (config.memory_budget_mb > 0 && job_active.load()) {
+                    maybeEnforceMemoryBudget();
+                }
+                lock.lock();
+            }
+        });
+    }
+
+    // Every ~5 s of active portfolio solving, compare the members' conflict
+    // rates over the window and flag the slowest for relaunch when it falls
+    // behind the best by more than 4x. One member per window keeps the
+    // portfolio from thrashing; quiet windows are ignored.
+    void maybeRelaunchSlowest() {
+        if (++adaptive_ticks < 50) {
+            return;
+        }
+        adaptive_ticks = 0;
+
+        // Relaunching reseeds from the packed formula copy, which a trim
+        // has given back to the system
+        if (!store.canReseed()) {
+            return;
+        }
+
+        uint64_t best = 0;
+        uint64_t worst_delta = UINT64_MAX;
+        size_t worst = 0;
+        for (size_t i = 0; i < num_thread_stats; i++) {
+            uint64_t now = thread_stats[i].conflicts.load(std::memory_order_relaxed);
+            // A freshly relaunched member restarts its counters from zero
+            uint64_t delta = now >= adaptive_last_conflicts[i]
+                                 ? now - adaptive_last_conflicts[i] : 0;
+            adaptive_last_conflicts[i] = now;
+            if (delta > best) {
+                best = delta;
+            }
+            if (delta < worst_delta) {
+                worst_delta = delta;
+                worst = i;
+            }
+        }
+
+        if (best < 1000 || worst_delta * 4 >= best) {
+            return;
+        }
+        if (relaunch_flags[worst].load()) {
+            return;
+        }
+        // Relaunching the proof producer would orphan its DRAT stream
+        if (excludeFromImports(worst)) {
+            return;
+        }
+
+        relaunch_flags[worst].store(true);
+        memberSnapshot(worst)->setSolverInterrupt();
+    }
+
+    // Watch the members' combined resident memory against the configured
+    // budget; at 90% occupancy, shed the heaviest member still in the race.
+    // One member per sampler tick keeps the degradation gradual.
+    void maybeEnforceMemoryBudget() {
+        // Shedding replaces the heavy member with a formula-only instance
+        // reseeded from the packed copy, which a trim has given back
+        if (!store.canReseed()) {
+            return;
+        }
+
+        // mem_peak is sampled in kB; the budget is configured in MiB
+        double total_kb = 0;
+        double heaviest_kb = -1;
+        size_t heaviest = num_thread_stats;
+        for (size_t i = 0; i < num_thread_stats; i++) {
+            double kb = thread_stats[i].mem_peak.load(std::memory_order_relaxed);
+            total_kb += kb;
+            if (!shed_flags[i].load() && kb > heaviest_kb) {
+                heaviest_kb = kb;
+                heaviest = i;
+            }
+        }
+
+        if (total_kb / 1024.0 < 0.9 * (double)config.memory_budget_mb ||
+            heaviest >= num_thread_stats) {
+            return;
+        }
+        // Never shed the proof producer: its DRAT stream cannot be resumed
+        if (excludeFromImports(heaviest)) {
+            return;
+        }
+
+        shed_flags[heaviest].store(true);
+        memberSnapshot(heaviest)->setSolverInterrupt();
+    }
+
+    // Replace a shed member's instance with a fresh formula-only one. Runs
+    // on the member's own worker thread, which then drops out of the race:
+    // the heavy instance stops allocating immediately and is released with
+    // the retired list at race end (the sampler and a racing winner may
+    // still hold its pointer, so it cannot be freed mid-race), while the
+    // replacement holds only the shared formula.
+    void shedMember(size_t idx) {
+        SolverInterface* old = solvers[idx];
+        SolverInterface* fresh = createMember((int)idx);
+        if (!fresh) {
+            return; // keep the old instance rather than a hole
+        }
+
+        store.reseed(fresh, idx);
+        {
+            std::lock_guard<std::mutex> lock(member_mutex);
+            solvers[idx] = fresh;
+        }
+
+        std::lock_guard<std::mutex> lock(retired_mutex);
+        retired_solvers.push_back(old);
+    }
+
+    // Relaunches cycle through the non-baseline presets, so a relaunched
+    // member always tries a block different from the portfolio default.
+    parameter relaunchParameters(int gen) {
+        return divPreset(1 + gen % (kNumDivPresets - 1));
+    }
+
+    // Replace one member with a freshly diversified instance. Runs on the
+    // member's own worker thread, so with pinning active the new instance is
+    // first-touched on the right node; reseeding from the warm store makes
+    // the relaunch one import pass. The old instance is retired, not
+    // released: other threads may still hold its pointer until the job ends.
+    void relaunchMember(size_t idx) {
+        SolverInterface* old = solvers[idx];
+        SolverInterface* fresh = SolverFactory::createKissatBonusSolver();
+        if (!fresh) {
+            relaunch_flags[idx].store(false);
+            old->unsetSolverInterrupt();
+            return;
+        }
+
+        int gen = ++relaunch_gen[idx];
+        fresh->setParameter(relaunchParameters(gen));
+        fresh->diversify((int)idx + config.random_seed + gen * (int)solvers.size());
+        store.reseed(fresh, idx);
+        wireTerminateCallback(fresh);
+
+        {
+            std::lock_guard<std::mutex> lock(retired_mutex);
+            retired_solvers.push_back(old);
+        }
+        {
+            std::lock_guard<std::mutex> lock(member_mutex);
+            solvers[idx] = fresh;
+        }
+        relaunch_flags[idx].store(false);
+    }
+
+    void releaseRetired() {
+        std::lock_guard<std::mutex> lock(retired_mutex);
+        for (auto* s : retired_solvers) {
+            s->release();
+        }
+        retired_solvers.clear();
+    }
+
+    // Drop the formula and every piece of state derived from it: the store,
+    // clauses injected mid-solve, results, scopes, and preprocessing maps.
+    // The next load starts from a clean slate.
+    void dropFormulaState() {
+        store.reset();
+
+        std::vector<ClauseExchange*> injected;
+        injected_clauses.getClauses(injected);
+        for (auto* clause : injected) {
+            ClauseManager::releaseClause(clause);
+        }
+
+        model.clear();
+        final_analysis.clear();
+        failed_assumptions.clear();
+        scope_selectors.clear();
+        num_variables = 0;
+        orig_variables = 0;
+        preprocessed = false;
+        pre_unsat = false;
+        pre_abandoned = false;
+        pre_mapto.clear();
+        pre_mapval.clear();
+        last_result = PARKISSAT_UNKNOWN;
+        interrupted.store(false);
+        winner_idx.store(-1);
+    }
+
+    void stopStatsSampler() {
+        if (!stats_thread.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex);
+            stats_shutdown = true;
+        }
+        stats_cv.notify_all();
+        stats_thread.join();
+    }
+
+    void workerLoop(size_t idx) {
+        if (idx < worker_cpusets.size()) {
+            pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+                                   &worker_cpusets[idx]);
+        }
+
+        uint64_t seen_generation = 0;
+
+        for (;;) {
+            std::vector<int> cube;
+            JobKind kind;
+            {
+                std::unique_lock<std::mutex> lock(pool_mutex);
+                pool_cv.wait(lock, [&] {
+                    return pool_shutdown || job_generation != seen_generation;
+                });
+                if (pool_shutdown) {
+                    return;
+                }
+                seen_generation = job_generation;
+                cube = *job_cube;
+                kind = job_kind;
+            }
+
+            if (kPerfEnabled) {
+                perf.dispatch_wake_ns.record(
+                    perf_now_ns() - perf_dispatch_ns.load(std::memory_order_relaxed));
+            }
+
+            if (kind == JOB_CUBES) {
+                solveCubesOn(idx, cube);
+            } else if (kind == JOB_DETERMINISTIC) {
+                solveDeterministicOn(idx, cube);
+            } else if (kind == JOB_BATCH) {
+                solveBatchOn(idx);
+            } else {
+                solveOneOn(idx, cube);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                if (--workers_remaining == 0) {
+                    done_cv.notify_all();
+                }
+            }
+        }
+    }
+
+    // Publish the winner's assignment without a lock: the solved CAS
+    // guarantees a single writer, the buffer was pre-sized at solve start so
+    // filling it allocates nothing, and the release store on winner_idx
+    // makes the finished buffer visible to any acquire reader. Values come
+    // straight from kissat_value() into direct-indexed form (slot v-1 holds
+    // the signed literal for variable v), skipping getModel()'s intermediate
+    // vector entirely.
+    void publishModel(SolverInterface* s, size_t idx) {
+        uint64_t t0 = kPerfEnabled ? perf_now_ns() : 0;
+
+        kissat* handle = ((KissatBonus*)s)->solver;
+        model.resize((size_t)num_variables);
+        for (int v = 1; v <= num_variables; v++) {
+            int value = kissat_value(handle, v);
+            model[v - 1] = value != 0 ? value : -v;
+        }
+        winner_idx.store((int)idx, std::memory_order_release);
+
+        if (kPerfEnabled) {
+            perf.models_published.fetch_add(1, std::memory_order_relaxed);
+            perf.model_readback_ns.record(perf_now_ns() - t0);
+        }
+    }
+
+    // Size the result buffers for the formula once per solve, so the winner
+    // path performs no allocation between "race won" and "result observable"
+    void prepareResultBuffers() {
+        model.clear();
+        if (num_variables > 0) {
+            model.reserve((size_t)num_variables);
+        }
+    }
+
+    // One portfolio race entry: solve the cube, try to win the result. When
+    // the adaptive manager flagged this member, the UNKNOWN is a kill: the
+    // worker relaunches its solver and rejoins the race.
+    void solveOneOn(size_t idx, const std::vector<int>& cube) {
+        for (;;) {
+            if (solved.load()) {
+                return;
+            }
+
+            SolverInterface* s = solvers[idx];
+            SatResult local_result = s->solve(cube);
+            store.markImported(idx);
+
+            if (local_result == SAT || local_result == UNSAT) {
+                bool expected = false;
+                if (solved.compare_exchange_strong(expected, true)) {
+                    // This thread found the result first
+                    job_result.store(local_result);
+                    if (local_result == SAT) {
+                        publishModel(s, idx);
+                    } else {
+                        final_analysis = s->getFinalAnalysis();
+                        winner_idx.store((int)idx, std::memory_order_release);
+                    }
+
+                    // Interrupt other solvers
+                    for (size_t i = 0; i < solvers.size(); i++) {
+                        if (i != idx) {
+                            memberSnapshot(i)->setSolverInterrupt();
+                        }
+                    }
+                }
+            }
+
+            refreshThreadStats(idx);
+
+            if (local_result == SAT || local_result == UNSAT || solved.load()) {
+                return;
+            }
+            if (shed_flags && shed_flags[idx].load()) {
+                shedMember(idx);
+                return;
+            }
+            if (!relaunch_flags || !relaunch_flags[idx].load()) {
+                return;
+            }
+            // A user interrupt or the deadline ends the race for this member
+            // too: a relaunched instance comes back with a fresh kissat that
+            // the one-shot interrupt broadcast would never reach
+            if (interrupted.load() || deadline_fired.load()) {
+                return;
+            }
+            relaunchMember(idx);
+        }
+    }
+
+    // Resolve one deterministic epoch. Runs on the last thread to reach the
+    // barrier, with det_mutex held, so it sees every member quiescent.
+    void deterministicEpochBoundary() {
+        // An interrupt or an expired deadline ends the run with UNKNOWN; this
+        // is the only nondeterministic exit, and it only exists because the
+        // caller asked for it.
+        if (interrupted.load() || deadline_fired.load()) {
+            det_done = true;
+            return;
+        }
+
+        // Deterministic winner rule: the lowest-indexed member that finished
+        // this epoch wins, regardless of wall-clock arrival order
+        for (size_t i = 0; i < det_results.size(); i++) {
+            if (det_results[i] != SAT && det_results[i] != UNSAT) {
+                continue;
+            }
+
+            det_done = true;
+            job_result.store(det_results[i]);
+            solved.store(true);
+
+            SolverInterface* s = solvers[i];
+            if (det_results[i] == SAT) {
+                publishModel(s, i);
+            } else {
+                final_analysis = s->getFinalAnalysis();
+                winner_idx.store((int)i, std::memory_order_release);
+            }
+            return;
+        }
+
+        // Nobody finished: exchange learned clauses synchronously, in member
+        // order, so every member enters the next epoch with the same imports
+        // the same run saw last time
+        std::vector<ClauseExchange*> learned;
+        for (size_t i = 0; i < solvers.size(); i++) {
+            learned.clear();
+            solvers[i]->getLearnedClauses(learned);
+            for (auto* clause : learned) {
+                int nconsumers = 0;
+                for (size_t j = 0; j < solvers.size(); j++) {
+                    if (j != i && !excludeFromImports(j)) {
+                        nconsumers++;
+                    }
+                }
+                ClauseManager::increaseClause(clause, nconsumers);
+                for (size_t j = 0; j < solvers.size(); j++) {
+                    if (j != i && !excludeFromImports(j)) {
+                        solvers[j]->addLearnedClause(clause);
+                    }
+                }
+                ClauseManager::releaseClause(clause);
+            }
+        }
+    }
+
+    // Epoch barrier: the last arriver resolves the epoch, then everyone is
+    // released together. Returns whether the deterministic run is over.
+    bool detBarrier() {
+        std::unique_lock<std::mutex> lock(det_mutex);
+        uint64_t gen = det_epoch_gen;
+        if (++det_arrived == solvers.size()) {
+            det_arrived = 0;
+            deterministicEpochBoundary();
+            det_epoch_gen++;
+            det_cv.notify_all();
+        } else {
+            det_cv.wait(lock, [&] { return det_epoch_gen != gen; });
+        }
+        return det_done;
+    }
+
+    // Deterministic portfolio entry: solve in fixed conflict-budget epochs,
+    // meeting the other members at the barrier after each one
+    void solveDeterministicOn(size_t idx, const std::vector<int>& cube) {
+        SolverInterface* s = solvers[idx];
+        kissat* handle = ((KissatBonus*)s)->solver;
+
+        for (;;) {
+            // kissat arms the limit relative to its current conflict count,
+            // so passing the budget alone gives every epoch exactly
+            // det_budget conflicts on top of where the previous one stopped
+            uint64_t budget = det_budget;
+            if (budget > 0xFFFFFFFFull) {
+                budget = 0xFFFFFFFFull;
+            }
+            kissat_set_conflict_limit(handle, (unsigned)budget);
+
+            det_results[idx] = s->solve(cube);
+            store.markImported(idx);
+            refreshThreadStats(idx);
+
+            if (detBarrier()) {
+                return;
+            }
+        }
+    }
+
+    // Cube-and-conquer entry: pull cubes off the shared cursor until they run
+    // out, a SAT cube wins, or the solve is interrupted. An UNSAT cube only
+    // refutes its part of the search space; the caller declares overall UNSAT
+    // once every cube has been refuted.
+    void solveCubesOn(size_t idx, const std::vector<int>& base) {
+        SolverInterface* s = solvers[idx];
+
+        while (!solved.load()) {
+            size_t ci = next_cube.fetch_add(1);
+            if (ci >= cubes.size()) {
+                return;
+            }
+
+            std::vector<int> full(base);
+            full.insert(full.end(), cubes[ci].begin(), cubes[ci].end());
+
+            SatResult local_result = s->solve(full);
+            store.markImported(idx);
+            refreshThreadStats(idx);
+
+            if (local_result == SAT) {
+                bool expected = false;
+                if (solved.compare_exchange_strong(expected, true)) {
+                    job_result.store(SAT);
+                    publishModel(s, idx);
+                    for (size_t i = 0; i < solvers.size(); i++) {
+                        if (i != idx) {
+                            memberSnapshot(i)->setSolverInterrupt();
+                        }
+                    }
+                }
+                return;
+            } else if (local_result == UNSAT) {
+                unsat_cubes.fetch_add(1);
+            } else {
+                return; // interrupted or out of budget
+            }
+        }
+    }
+
+    // Batch entry: pull assumption queries off the shared cursor until they
+    // run out or the solve is cut short. Slots decided during translation
+    // (an assumption fixed false by preprocessing) are skipped.
+    void solveBatchOn(size_t idx) {
+        SolverInterface* s = solvers[idx];
+
+        while (!interrupted.load() && !deadline_fired.load()) {
+            size_t q = next_query.fetch_add(1);
+            if (q >= batch_queries.size()) {
+                return;
+            }
+            if (batch_results[q] != PARKISSAT_UNKNOWN) {
+                continue;
+            }
+
+            SatResult local_result = s->solve(batch_queries[q]);
+            store.markImported(idx);
+            refreshThreadStats(idx);
+
+            if (local_result == SAT) {
+                batch_results[q] = PARKISSAT_SAT;
+            } else if (local_result == UNSAT) {
+                batch_results[q] = PARKISSAT_UNSAT;
+            }
+            // UNKNOWN (interrupt, deadline) leaves the slot undecided
+        }
+    }
+
+    // Drain one translated query batch: on the persistent pool when there is
+    // one, inline on the caller's thread for a single-member portfolio. The
+    // asynchronous Sharer stays off — clauses learned under assumptions may
+    // depend on them and must not leak between members.
+    void runBatch() {
+        if (!interrupted.load()) {
+            for (auto* s : solvers) {
+                s->unsetSolverInterrupt();
+            }
+        }
+
+        // A batch has no single winner; clear the previous solve's so
+        // parkissat_get_winner() does not report a stale member
+        winner_idx.store(-1);
+        next_query.store(0);
+
+        if (workers.empty()) {
+            solveBatchOn(0);
+            return;
+        }
+
+        static const std::vector<int> no_cube;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            job_cube = &no_cube;
+            job_kind = JOB_BATCH;
+            workers_remaining = workers.size();
+            job_generation++;
+        }
+        perfMarkDispatch();
+        pool_cv.notify_all();
+
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            done_cv.wait(lock, [&] { return workers_remaining == 0; });
+        }
+    }
+
+    // Split the search space into 2^depth cubes over the most frequently
+    // occurring variables — a cheap static proxy for a lookahead splitter
+    // that needs no solver support.
+    void generateCubes() {
+        cubes.clear();
+
+        int depth = config.cube_split_depth;
+        if (depth <= 0) {
+            // Aim for roughly 4 cubes per worker
+            size_t target = 4 * (solvers.empty() ? 1 : solvers.size());
+            depth = 0;
+            while ((size_t(1) << depth) < target && depth < 12) {
+                depth++;
+            }
+        }
+        if (depth > 20) {
+            depth = 20;
+        }
+
+        // Rank variables by occurrence count
+        std::vector<uint32_t> occurrences(num_variables + 1, 0);
+        for (auto* clause : store.arena.clauses) {
+            for (int i = 0; i < clause->size; i++) {
+                int var = abs(clause->lits[i]);
+                if (var <= num_variables) {
+                    occurrences[var]++;
+                }
+            }
+        }
+
+        std::vector<int> split_vars;
+        for (int d = 0; d < depth; d++) {
+            int best = 0;
+            for (int v = 1; v <= num_variables; v++) {
+                if (occurrences[v] > 0 && (best == 0 || occurrences[v] > occurrences[best])) {
+                    best = v;
+                }
+            }
+            if (best == 0) {
+                break; // fewer candidate variables than requested depth
+            }
+            occurrences[best] = 0;
+            split_vars.push_back(best);
+        }
+
+        size_t num_cubes = size_t(1) << split_vars.size();
+        cubes.reserve(num_cubes);
+        for (size_t mask = 0; mask < num_cubes; mask++) {
+            std::vector<int> cube(split_vars.size());
+            for (size_t b = 0; b < split_vars.size(); b++) {
+                cube[b] = (mask & (size_t(1) << b)) ? split_vars[b] : -split_vars[b];
+            }
+            cubes.push_back(std::move(cube));
+        }
+    }
+
+    // Run the cube-and-conquer engine: split, drain the cube queue across all
+    // workers, and aggregate. SAT on any cube is SAT; UNSAT requires every
+    // cube to be refuted.
+    SatResult runCubeAndConquer(const std::vector<int>& base) {
+        generateCubes();
+        next_cube.store(0);
+        unsat_cubes.store(0);
+        solved.store(false);
+        job_result.store(UNKNOWN);
+        winner_idx.store(-1);
+        prepareResultBuffers();
+
+        if (!interrupted.load()) {
+            for (auto* s : solvers) {
+                s->unsetSolverInterrupt();
+            }
+        }
+
+        if (solvers.size() == 1) {
+            solveCubesOn(0, base);
+        } else {
+            globalEnding = false;
+            startSharing();
+
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                job_cube = &base;
+                job_kind = JOB_CUBES;
+                workers_remaining = workers.size();
+                job_generation++;
+            }
+            perfMarkDispatch();
+            pool_cv.notify_all();
+
+            {
+                std::unique_lock<std::mutex> lock(pool_mutex);
+                done_cv.wait(lock, [&] { return workers_remaining == 0; });
+            }
+
+            stopSharing();
+        }
+
+        if (!solved.load() && unsat_cubes.load() == cubes.size()) {
+            return UNSAT;
+        }
+        return job_result.load();
+    }
+
+    // Run one portfolio race on the persistent pool and block until every
+    // worker has parked again, so the pool is immediately reusable.
+    SatResult runPortfolio(const std::vector<int>& cube) {
+        solved.store(false);
+        job_result.store(UNKNOWN);
+        winner_idx.store(-1);
+        prepareResultBuffers();
+
+        // The winner of the previous race interrupted every other solver;
+        // clear those flags unless the user asked for an interrupt themselves.
+        if (!interrupted.load()) {
+            for (auto* s : solvers) {
+                s->unsetSolverInterrupt();
+            }
+        }
+
+        if (config.enable_deterministic) {
+            return runDeterministic(cube);
+        }
+
+        // Members shed by a previous race's memory budget rejoin this one
+        if (shed_flags) {
+            for (size_t i = 0; i < num_thread_stats; i++) {
+                shed_flags[i].store(false);
+            }
+        }
+
+        globalEnding = false;
+        startSharing();
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            job_cube = &cube;
+            job_kind = JOB_PORTFOLIO;
+            workers_remaining = workers.size();
+            job_generation++;
+        }
+        job_active.store(true);
+        perfMarkDispatch();
+        pool_cv.notify_all();
+
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            done_cv.wait(lock, [&] { return workers_remaining == 0; });
+        }
+        job_active.store(false);
+
+        stopSharing();
+        releaseRetired();
+
+        return job_result.load();
+    }
+
+    // Run one deterministic epoch race. The asynchronous Sharer stays off —
+    // its exchange timing is scheduling-dependent — and clause exchange
+    // happens at the epoch barrier instead.
+    SatResult runDeterministic(const std::vector<int>& cube) {
+        det_done = false;
+        det_arrived = 0;
+        det_epoch_gen = 0;
+        det_results.assign(solvers.size(), UNKNOWN);
+        det_budget = config.deterministic_conflict_budget > 0
+                         ? (uint64_t)config.deterministic_conflict_budget
+                         : 4096;
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            job_cube = &cube;
+            job_kind = JOB_DETERMINISTIC;
+            workers_remaining = workers.size();
+            job_generation++;
+        }
+        perfMarkDispatch();
+        pool_cv.notify_all();
+
+        {
+            std::unique_lock<std::mutex> lock(pool_mutex);
+            done_cv.wait(lock, [&] { return workers_remaining == 0; });
+        }
+
+        // Lift the per-epoch conflict limits again so a later
+        // non-deterministic solve is not cut short by a stale budget
+        for (auto* s : solvers) {
+            kissat_set_conflict_limit(((KissatBonus*)s)->solver, (unsigned)-1);
+        }
+
+        return job_result.load();
+    }
+
+    ~ParkissatSolver() {
+        if (async_thread.joinable()) {
+            interrupted.store(true); // also ends a deterministic run at its next barrier
+            for (size_t i = 0; i < solvers.size(); i++) {
+                memberSnapshot(i)->setSolverInterrupt();
+            }
+            async_thread.join();
+        }
+        disarmDeadline();
+        stopStatsSampler();
+        shutdownPool();
+        stopSharing();
+        stopProof();
+
+        // Clause memory is owned by the arena and freed with it
+
+        // Clean up solvers
+        for (auto* solver : solvers) {
+            solver->release();
+        }
+        releaseRetired();
+
+        // Release clauses injected mid-solve, now that no solver holds them
+        std::vector<ClauseExchange*> injected;
+        injected_clauses.getClauses(injected);
+        for (auto* clause : injected) {
+            ClauseManager::releaseClause(clause);
+        }
+    }
+};
+
+// The painless sharing components read their tuning knobs from the global
+// Parameters map, which is normally filled from the command line. Synthesize
+// an argv from the wrapper config instead.
+static void apply_sharing_parameters(const ParkissatConfig* config) {
+    std::vector<std::string> args;
+    args.push_back("parkissat");
+
+    if (config->sharing_interval_us > 0) {
+        args.push_back("-shr-sleep=" + std::to_string(config->sharing_interval_us));
+    }
+    if (config->sharing_lit_budget > 0) {
+        args.push_back("-shr-lit=" + std::to_string(config->sharing_lit_budget));
+    }
+    if (config->sharing_lbd_limit > 0) {
+        args.push_back("-lbd-limit=" + std::to_string(config->sharing_lbd_limit));
+    }
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+
+    Parameters::init(static_cast<int>(argv.size()), argv.data());
+}
+
+ParkissatSolver* parkissat_new(void) {
+    try {
+        return new ParkissatSolver();
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void parkissat_delete(ParkissatSolver* solver) {
+    if (solver) {
+        delete solver;
+    }
+}
+
+void parkissat_configure(ParkissatSolver* solver, const ParkissatConfig* config) {
+    if (!solver || !config) return;
+    
+    solver->config = *config;
+
+    if (config->enable_clause_sharing) {
+        apply_sharing_parameters(config);
+    }
+
+    // Initialize solvers based on configuration
+    solver->stopStatsSampler();
+    solver->shutdownPool();
+    solver->stopProof();
+    solver->solvers.clear();
+
+    // After a trim the packed formula copy is gone, so a rebuilt portfolio
+    // could only be fed the post-trim tail — silently an incomplete formula.
+    // Drop the formula state instead and require a fresh load, exactly as
+    // parkissat_reset() leaves it.
+    if (!solver->store.canReseed()) {
+        solver->dropFormulaState();
+    }
+    
+    // Resolve the portfolio size. -1 means auto: one member per physical
+    // core (a second kissat on a hyperthread sibling costs more in shared
+    // cache and execution-port pressure than it adds), capped so every
+    // member keeps roughly 512 MiB of the memory available right now.
+    int physical = count_physical_cores();
+    int num_solvers;
+    if (config->num_threads > 0) {
+        num_solvers = config->num_threads;
+    } else if (config->num_threads < 0) {
+        num_solvers = physical;
+        long avail_mb = available_memory_mb();
+        if (avail_mb > 0) {
+            long cap = avail_mb / 512;
+            if (cap < 1) cap = 1;
+            if (num_solvers > cap) num_solvers = (int)cap;
+        }
+        if (config->memory_budget_mb > 0) {
+            long cap = config->memory_budget_mb / 512;
+            if (cap < 1) cap = 1;
+            if (num_solvers > cap) num_solvers = (int)cap;
+        }
+    } else {
+        num_solvers = 1;
+    }
+
+
+    for (int i = 0; i < num_solvers; i++) {
+        // Create a solver instance (using KissatBonus as default)
+        SolverInterface* s = solver->createMember(i);
+        if (s) {
+            solver->solvers.push_back(s);
+        }
+    }
+
+    // Record the layout actually built, for parkissat_get_layout()
+    solver->layout.num_threads = (int)solver->solvers.size();
+    solver->layout.physical_cores = physical;
+    solver->layout.numa_nodes = (int)detect_numa_topology().node_cpus.size();
+    solver->layout.auto_selected = config->num_threads < 0;
+
+    // Bind the shared store to the new portfolio; if a formula is already
+    // loaded (reconfiguration), hand the single packed copy to every member
+    solver->store.attach(solver->solvers.size());
+    if (!solver->deferDistribution()) {
+        solver->store.distribute(solver->solvers);
+    }
+
+    solver->startStatsSampler();
+
+    if (solver->solvers.size() > 1) {
+        solver->startPool();
+    }
+}
+
+void parkissat_get_layout(ParkissatSolver* solver, ParkissatLayout* layout) {
+    if (!solver || !layout) return;
+    *layout = solver->layout;
+}
+
+void parkissat_reset(ParkissatSolver* solver) {
+    if (!solver || solver->solvers.empty()) return;
+
+    try {
+        // The proof stream belongs to the old formula
+        solver->stopProof();
+
+        // Recreate the members. kissat has no in-place clear, so fresh
+        // instances are the only way to drop the formula — but instance
+        // construction is the cheap part of configuration; the worker pool
+        // threads, the stats arrays, and the arena slabs all stay alive.
+        for (size_t i = 0; i < solver->solvers.size(); i++) {
+            SolverInterface* fresh = solver->createMember((int)i);
+            if (!fresh) {
+                continue; // keep the old instance rather than a hole
+            }
+            // Swap under the member lock and release only after it: the
+            // stats sampler reads these slots under the same lock, so once
+            // the swap is published no reader can still hold the old pointer
+            SolverInterface* old;
+            {
+                std::lock_guard<std::mutex> lock(solver->member_mutex);
+                old = solver->solvers[i];
+                solver->solvers[i] = fresh;
+            }
+            old->release();
+        }
+        solver->releaseRetired();
+
+        // Drop the formula; the retired slabs are recycled by the next load
+        solver->dropFormulaState();
+
+        // Fresh members start from zeroed counters
+        for (size_t i = 0; i < solver->num_thread_stats; i++) {
+            solver->refreshThreadStats(i);
+        }
+    } catch (...) {
+        // Handle exception
+    }
+}
+
+uint64_t parkissat_trim_memory(ParkissatSolver* solver) {
+    if (!solver || solver->solvers.empty()) return 0;
+
+    // Only between solves: a running race may be mid-reseed
+    if (solver->async_running.load() || solver->job_active.load()) return 0;
+
+    return (uint64_t)solver->store.trim();
+}
+
+// One parser thread's share of the DIMACS body. Complete clauses (first 0
+// terminator to last 0 terminator of the chunk) land in lits/offsets; the
+// literals before the first 0 and after the last one are kept aside so
+// clauses crossing a chunk boundary can be stitched back together in order.
+struct DimacsChunk {
+    std::vector<int> lits;
+    std::vector<size_t> offsets;  // clause i spans [offsets[i], offsets[i+1])
+    std::vector<int> prefix;      // literals before the first terminator
+    std::vector<int> suffix;      // literals after the last terminator
+    bool has_terminator = false;
+    int max_var = 0;
+};
+
+// Scan integers out of [begin, end). Comment lines and the trailing '%' of
+// some generators are skipped; everything else must be literals and 0
+// terminators.
+static void parse_dimacs_chunk(const char* begin, const char* end, DimacsChunk* chunk) {
+    chunk->offsets.push_back(0);
+
+    std::vector<int> current;
+    const char* p = begin;
+
+    while (p < end) {
+        char c = *p;
+
+        if (c == 'c' || c == 'p' || c == '%') {
+            // Skip the rest of the line
+            while (p < end && *p != '\n') p++;
+            continue;
+        }
+
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            p++;
+            continue;
+        }
+
+        bool negative = false;
+        if (c == '-') {
+            negative = true;
+            p++;
+        }
+
+        int value = 0;
+        const char* digits_begin = p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value = value * 10 + (*p - '0');
+            p++;
+        }
+        if (p == digits_begin) {
+            // Not a number; skip the offending character
+            if (!negative) p++;
+            continue;
+        }
+
+        if (value == 0) {
+            // Clause terminator. A bare terminator records a zero-length
+            // entry: an explicit empty clause, which refutes the formula.
+            if (!chunk->has_terminator) {
+                chunk->prefix = current;
+                chunk->has_terminator = true;
+            } else {
+                chunk->lits.insert(chunk->lits.end(), current.begin(), current.end());
+                chunk->offsets.push_back(chunk->lits.size());
+            }
+            current.clear();
+            continue;
+        }
+
+        if (value > chunk->max_var) {
+            chunk->max_var = value;
+        }
+        current.push_back(negative ? -value : value);
+    }
+
+    if (!chunk->has_terminator) {
+        chunk->prefix = current;
+    } else {
+        chunk->suffix = current;
+    }
+}
+
+// Multi-threaded parse of one in-memory DIMACS body. The body is chunked
+// across parser threads (each chunk starts after the next newline), the
+// resulting clauses are packed into the arena in file order, and the formula
+// is installed into every portfolio member.
+static bool load_dimacs_buffer(ParkissatSolver* solver, const char* data, size_t file_size) {
+    bool ok = false;
+    try {
+        // Locate the problem line to learn the declared variable count
+        int header_vars = 0;
+        const char* p = data;
+        const char* end = data + file_size;
+        while (p < end) {
+            if (*p == 'p') {
+                sscanf(p, "p cnf %d", &header_vars);
+                break;
+            }
+            while (p < end && *p != '\n') p++;
+            if (p < end) p++;
+        }
+
+        // One chunk per hardware thread, but no tiny chunks
+        size_t num_chunks = std::thread::hardware_concurrency();
+        if (num_chunks == 0) num_chunks = 1;
+        if (num_chunks > 16) num_chunks = 16;
+        const size_t kMinChunk = 1 << 22; // 4 MiB
+        if (file_size / kMinChunk < num_chunks) {
+            num_chunks = file_size / kMinChunk + 1;
+        }
+
+        std::vector<DimacsChunk> chunks(num_chunks);
+        std::vector<std::thread> parsers;
+
+        std::vector<const char*> starts(num_chunks + 1);
+        starts[0] = data;
+        for (size_t i = 1; i < num_chunks; i++) {
+            const char* s = data + (file_size / num_chunks) * i;
+            while (s < end && *s != '\n') s++;
+            if (s < end) s++;
+            starts[i] = s;
+        }
+        starts[num_chunks] = end;
+
+        for (size_t i = 0; i < num_chunks; i++) {
+            parsers.emplace_back(parse_dimacs_chunk, starts[i], starts[i + 1], &chunks[i]);
+        }
+        for (auto& t : parsers) {
+            t.join();
+        }
+
+        // Stitch boundary clauses and bulk-ingest in file order
+        size_t total_bytes = 0;
+        int max_var = header_vars;
+        for (auto& chunk : chunks) {
+            for (size_t i = 0; i + 1 < chunk.offsets.size(); i++) {
+                total_bytes += ClauseArena::footprintOf((int)(chunk.offsets[i + 1] - chunk.offsets[i]));
+            }
+            total_bytes += ClauseArena::footprintOf((int)(chunk.prefix.size() + chunk.suffix.size() + 1));
+            if (chunk.max_var > max_var) {
+                max_var = chunk.max_var;
+            }
+        }
+        solver->store.arena.reserve(total_bytes);
+
+        std::vector<int> carry;
+        std::vector<int> mapped;
+        auto emit = [&](const int* lits, size_t size) {
+            // A genuine empty clause (a bare 0 line) refutes the formula
+            // outright; boundary-stitching artifacts never reach here
+            if (size == 0) {
+                solver->pre_unsat = true;
+                return;
+            }
+
+            // Loading on top of an already-preprocessed formula translates
+            // each clause into the reduced variable space
+            if (solver->preprocessed) {
+                mapped.clear();
+                for (size_t i = 0; i < size; i++) {
+                    int lit;
+                    int fixed = solver->mapLiteral(lits[i], &lit);
+                    if (fixed > 0) return; // satisfied by a preprocessed value
+                    if (fixed == 0) mapped.push_back(lit);
+                }
+                if (mapped.empty()) {
+                    solver->pre_unsat = true;
+                    return;
+                }
+                lits = mapped.data();
+                size = mapped.size();
+            }
+
+            ClauseExchange* clause = solver->store.arena.alloc((int)size);
+            if (!clause) throw std::bad_alloc();
+            memcpy(clause->lits, lits, size * sizeof(int));
+        };
+
+        for (auto& chunk : chunks) {
+            carry.insert(carry.end(), chunk.prefix.begin(), chunk.prefix.end());
+            if (chunk.has_terminator) {
+                emit(carry.data(), carry.size());
+                carry.clear();
+
+                for (size_t i = 0; i + 1 < chunk.offsets.size(); i++) {
+                    emit(chunk.lits.data() + chunk.offsets[i],
+                         chunk.offsets[i + 1] - chunk.offsets[i]);
+                }
+                carry = chunk.suffix;
+            }
+        }
+        // Unterminated final clause; an empty carry just means the file
+        // ended cleanly at a terminator
+        if (!carry.empty()) {
+            emit(carry.data(), carry.size());
+        }
+
+        if (!solver->preprocessed && max_var > solver->num_variables) {
+            solver->num_variables = max_var;
+        }
+
+        // Install the formula into every portfolio member
+        if (!solver->deferDistribution()) {
+            solver->store.distribute(solver->solvers);
+        }
+
+        ok = true;
+    } catch (...) {
+        ok = false;
+    }
+
+    return ok;
+}
+
+static bool ends_with(const char* s, const char* suffix) {
+    size_t n = strlen(s);
+    size_t m = strlen(suffix);
+    return n >= m && memcmp(s + n - m, suffix, m) == 0;
+}
+
+// Stream a gzip-compressed file into memory through zlib (already linked for
+// the crate), growing the buffer a megabyte at a time.
+static bool inflate_gz_file(const char* filename, std::vector<char>* out) {
+    gzFile gz = gzopen(filename, "rb");
+    if (!gz) return false;
+    gzbuffer(gz, 1 << 20);
+
+    const size_t kChunk = 1 << 20;
+    size_t used = 0;
+    bool ok = true;
+    for (;;) {
+        out->resize(used + kChunk);
+        int n = gzread(gz, out->data() + used, (unsigned)kChunk);
+        if (n < 0) {
+            ok = false;
+            break;
+        }
+        used += (size_t)n;
+        if ((size_t)n < kChunk) break;
+    }
+    out->resize(used);
+    gzclose(gz);
+    return ok && used > 0;
+}
+
+// Stream an xz-compressed file through the system xz tool; liblzma is not a
+// dependency of this crate, and xz -dc overlaps its decompression with our
+// parse setup for free.
+static bool inflate_xz_file(const char* filename, std::vector<char>* out) {
+    std::string cmd = "xz -dc -- '";
+    for (const char* p = filename; *p; p++) {
+        if (*p == '\'') {
+            cmd += "'\\''";
+        } else {
+            cmd += *p;
+        }
+    }
+    cmd += "'";
+
+    FILE* pipe = popen(cmd.c_str(), "r");
+    if (!pipe) return false;
+
+    const size_t kChunk = 1 << 20;
+    size_t used = 0;
+    for (;;) {
+        out->resize(used + kChunk);
+        size_t n = fread(out->data() + used, 1, kChunk, pipe);
+        used += n;
+        if (n < kChunk) break;
+    }
+    out->resize(used);
+    return pclose(pipe) == 0 && used > 0;
+}
+
+// DIMACS loader. Plain files are memory-mapped; .gz and .xz files are
+// decompressed straight into memory — no temp files, no second pass over the
+// disk — and then handed to the same multi-threaded buffer parser.
+bool parkissat_load_dimacs(ParkissatSolver* solver, const char* filename) {
+    if (!solver || !filename) return false;
+    if (solver->solvers.empty()) return false;
+
+    if (ends_with(filename, ".gz") || ends_with(filename, ".xz")) {
+        std::vector<char> body;
+        bool inflated = ends_with(filename, ".gz")
+                            ? inflate_gz_file(filename, &body)
+                            : inflate_xz_file(filename, &body);
+        if (!inflated) return false;
+        return load_dimacs_buffer(solver, body.data(), body.size());
+    }
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    size_t file_size = (size_t)st.st_size;
+
+    const char* data = (const char*)mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    madvise((void*)data, file_size, MADV_SEQUENTIAL);
+
+    bool ok = load_dimacs_buffer(solver, data, file_size);
+
+    munmap((void*)data, file_size);
+    return ok;
+}
+
+// Warm-start snapshots. The format is a compact host-byte-order binary blob:
+// a header with the variable counts, preprocessing maps, and open scope
+// selectors; the formula exactly as the store holds it; then, per member,
+// the export-quality learned clauses it currently offers, filtered by LBD.
+// Written and read with a 1 MiB stdio buffer so both directions are one
+// sequential pass. Snapshots must be taken and restored between solves.
+static const uint32_t kStateMagic = 0x504b5354; // "PKST"
+static const uint32_t kStateVersion = 1;
+
+bool parkissat_save_state(ParkissatSolver* solver, const char* path) {
+    if (!solver || !path) return false;
+
+    // The snapshot writes the formula from the packed copy, which a trim
+    // has given back to the system
+    if (!solver->store.canReseed()) return false;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    std::vector<char> iobuf(1 << 20);
+    setvbuf(f, iobuf.data(), _IOFBF, iobuf.size());
+
+    bool ok = true;
+    auto w32 = [&](uint32_t v) { ok = ok && fwrite(&v, sizeof v, 1, f) == 1; };
+    auto w64 = [&](uint64_t v) { ok = ok && fwrite(&v, sizeof v, 1, f) == 1; };
+    auto wints = [&](const int* p, size_t n) {
+        ok = ok && (n == 0 || fwrite(p, sizeof(int), n, f) == n);
+    };
+
+    try {
+        w32(kStateMagic);
+        w32(kStateVersion);
+        w32((uint32_t)solver->num_variables);
+
+        w32(solver->preprocessed ? 1u : 0u);
+        w32((uint32_t)solver->orig_variables);
+        if (solver->preprocessed) {
+            w64(solver->pre_mapto.size());
+            wints(solver->pre_mapto.data(), solver->pre_mapto.size());
+            wints(solver->pre_mapval.data(), solver->pre_mapval.size());
+        }
+
+        w32((uint32_t)solver->scope_selectors.size());
+        wints(solver->scope_selectors.data(), solver->scope_selectors.size());
+
+        // The formula, exactly as the store holds it
+        w64(solver->store.numClauses());
+        for (auto* clause : solver->store.arena.clauses) {
+            w32((uint32_t)clause->size);
+            wints(clause->lits, clause->size);
+        }
+
+        // Per member: the learned clauses currently offered for export.
+        // Draining the buffer transfers the references to us, so each clause
+        // is released once written.
+        int lbd_limit = solver->config.sharing_lbd_limit > 0
+                            ? solver->config.sharing_lbd_limit : 4;
+        w32((uint32_t)solver->solvers.size());
+        std::vector<ClauseExchange*> learned;
+        for (auto* s : solver->solvers) {
+            learned.clear();
+            s->getLearnedClauses(learned);
+
+            uint64_t kept = 0;
+            for (auto* clause : learned) {
+                if (clause->lbd <= lbd_limit) kept++;
+            }
+            w64(kept);
+
+            for (auto* clause : learned) {
+                if (clause->lbd <= lbd_limit) {
+                    w32((uint32_t)clause->lbd);
+                    w32((uint32_t)clause->size);
+                    wints(clause->lits, clause->size);
+                }
+                ClauseManager::releaseClause(clause);
+            }
+        }
+    } catch (...) {
+        ok = false;
+    }
+
+    if (fclose(f) != 0) ok = false;
+    return ok;
+}
+
+bool parkissat_load_state(ParkissatSolver* solver, const char* path) {
+    if (!solver || solver->solvers.empty() || !path) return false;
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    std::vector<char> iobuf(1 << 20);
+    setvbuf(f, iobuf.data(), _IOFBF, iobuf.size());
+
+    bool ok = true;
+    auto r32 = [&]() -> uint32_t {
+        uint32_t v = 0;
+        ok = ok && fread(&v, sizeof v, 1, f) == 1;
+        return v;
+    };
+    auto r64 = [&]() -> uint64_t {
+        uint64_t v = 0;
+        ok = ok && fread(&v, sizeof v, 1, f) == 1;
+        return v;
+    };
+    auto rints = [&](int* p, size_t n) {
+        ok = ok && (n == 0 || fread(p, sizeof(int), n, f) == n);
+    };
+
+    try {
+        if (r32() != kStateMagic || r32() != kStateVersion || !ok) {
+            fclose(f);
+            return false;
+        }
+
+        solver->num_variables = (int)r32();
+
+        solver->preprocessed = r32() != 0;
+        solver->orig_variables = (int)r32();
+        if (solver->preprocessed) {
+            size_t map_size = (size_t)r64();
+            solver->pre_mapto.assign(map_size, 0);
+            solver->pre_mapval.assign(map_size, 0);
+            rints(solver->pre_mapto.data(), map_size);
+            rints(solver->pre_mapval.data(), map_size);
+        }
+
+        size_t num_selectors = r32();
+        solver->scope_selectors.assign(num_selectors, 0);
+        rints(solver->scope_selectors.data(), num_selectors);
+
+        // The formula goes back into the arena in snapshot order
+        uint64_t num_clauses = r64();
+        for (uint64_t i = 0; ok && i < num_clauses; i++) {
+            int size = (int)r32();
+            if (!ok || size <= 0) {
+                ok = false;
+                break;
+            }
+            ClauseExchange* clause = solver->store.arena.alloc(size);
+            if (!clause) {
+                ok = false;
+                break;
+            }
+            rints(clause->lits, size);
+        }
+
+        // Learned clauses are handed to the members round-robin, so a
+        // snapshot from a wider portfolio still restores completely. Each
+        // restored clause carries one reference, owned by its consumer.
+        uint32_t saved_members = r32();
+        for (uint32_t i = 0; ok && i < saved_members; i++) {
+            // With proof logging active the round-robin skips member 0, which
+            // must not import learned clauses it did not derive
+            size_t ti;
+            if (solver->proof_active && solver->solvers.size() > 1) {
+                ti = 1 + i % (solver->solvers.size() - 1);
+            } else {
+                ti = i % solver->solvers.size();
+            }
+            SolverInterface* target = solver->solvers[ti];
+            uint64_t count = r64();
+            for (uint64_t c = 0; ok && c < count; c++) {
+                int lbd = (int)r32();
+                int size = (int)r32();
+                if (!ok || size <= 0) {
+                    ok = false;
+                    break;
+                }
+                ClauseExchange* clause = ClauseManager::allocClause(size);
+                if (!clause) {
+                    ok = false;
+                    break;
+                }
+                clause->lbd = lbd;
+                clause->from = -1;
+                rints(clause->lits, size);
+                if (ok && !solver->excludeFromImports(ti)) {
+                    target->addLearnedClause(clause);
+                } else {
+                    ClauseManager::releaseClause(clause);
+                }
+            }
+        }
+
+        if (ok && !solver->deferDistribution()) {
+            solver->store.distribute(solver->solvers);
+        }
+    } catch (...) {
+        ok = false;
+    }
+
+    fclose(f);
+    return ok;
+}
+
+bool parkissat_set_proof_file(ParkissatSolver* solver, const char* path) {
+    if (!solver) return false;
+
+    try {
+        solver->stopProof();
+        if (!path) {
+            return true;
+        }
+        return solver->startProof(path);
+    } catch (...) {
+        return false;
+    }
+}
+
+// Allocate one clause in the arena and hand it to every solver. When
+// tag_scope is set and a push/pop scope is open, the clause additionally
+// carries the negated innermost selector so it can be retracted by pop.
+static void ingest_clause(ParkissatSolver* solver, const int* literals, int size, bool tag_scope) {
+    int extra = (tag_scope && !solver->scope_selectors.empty()) ? 1 : 0;
+
+    // After preprocessing, caller literals are in the original numbering and
+    // must be translated; fixed-true literals satisfy the clause, fixed-false
+    // ones are dropped. Scope selectors already live in the reduced space.
+    std::vector<int> mapped;
+    if (solver->preprocessed) {
+        mapped.reserve(size);
+        for (int i = 0; i < size; i++) {
+            int lit;
+            int fixed = solver->mapLiteral(literals[i], &lit);
+            if (fixed > 0) {
+                return; // clause already satisfied by a preprocessed value
+            }
+            if (fixed == 0) {
+                mapped.push_back(lit);
+            }
+        }
+        literals = mapped.data();
+        size = (int)mapped.size();
+        if (size == 0 && extra == 0) {
+            solver->pre_unsat = true; // every literal fixed false
+            return;
+        }
+    }
+
+    ClauseExchange* clause = solver->store.arena.alloc(size + extra);
+    if (!clause) return;
+
+    // Copy literals
+    for (int i = 0; i < size; i++) {
+        clause->lits[i] = literals[i];
+
+        // Update variable count
+        int var = abs(literals[i]);
+        if (var > solver->num_variables) {
+            solver->num_variables = var;
+        }
+    }
+
+    if (extra) {
+        clause->lits[size] = -solver->scope_selectors.back();
+    }
+
+    // Hand the single shared copy to every solver
+    if (!solver->deferDistribution()) {
+        solver->store.distribute(solver->solvers);
+    }
+}
+
+void parkissat_add_clause(ParkissatSolver* solver, const int* literals, int size) {
+    if (!solver || !literals || size <= 0) return;
+
+    try {
+        ingest_clause(solver, literals, size, true);
+    } catch (...) {
+        // Handle exception
+    }
+}
+
+// Ingest a whole formula in one call. flat_lits holds all literals back to
+// back; clause i spans [clause_offsets[i], clause_offsets[i+1]), so
+// clause_offsets has num_clauses + 1 entries. The arena is pre-sized so the
+// whole batch lands in one slab.
+void parkissat_add_clauses(ParkissatSolver* solver, const int* flat_lits,
+                           const int* clause_offsets, int num_clauses) {
+    if (!solver || !flat_lits || !clause_offsets || num_clauses <= 0) return;
+
+    try {
+        // After preprocessing each clause needs literal translation, which can
+        // shrink or drop it; take the one-clause path that knows how.
+        if (solver->preprocessed) {
+            for (int i = 0; i < num_clauses; i++) {
+                int size = clause_offsets[i + 1] - clause_offsets[i];
+                if (size <= 0) return;
+                ingest_clause(solver, flat_lits + clause_offsets[i], size, true);
+            }
+            return;
+        }
+
+        int extra = solver->scope_selectors.empty() ? 0 : 1;
+
+        size_t batch_bytes = 0;
+        for (int i = 0; i < num_clauses; i++) {
+            int size = clause_offsets[i + 1] - clause_offsets[i];
+            if (size <= 0) return;
+            batch_bytes += ClauseArena::footprintOf(size + extra);
+        }
+
+        if (!solver->store.arena.reserve(batch_bytes)) return;
+        solver->store.arena.clauses.reserve(solver->store.arena.clauses.size() + num_clauses);
+
+        int max_var = solver->num_variables;
+        for (int i = 0; i < num_clauses; i++) {
+            int size = clause_offsets[i + 1] - clause_offsets[i];
+            const int* lits = flat_lits + clause_offsets[i];
+
+            ClauseExchange* clause = solver->store.arena.alloc(size + extra);
+            if (!clause) return;
+
+            for (int j = 0; j < size; j++) {
+                clause->lits[j] = lits[j];
+
+                int var = abs(lits[j]);
+                if (var > max_var) {
+                    max_var = var;
+                }
+            }
+
+            if (extra) {
+                clause->lits[size] = -solver->scope_selectors.back();
+            }
+        }
+        solver->num_variables = max_var;
+
+        // Distribute to every solver in a single pass per solver
+        if (!solver->deferDistribution()) {
+            solver->store.distribute(solver->solvers);
+        }
+    } catch (...) {
+        // Handle exception
     }
-};
+}
+
+int parkissat_get_variable_count(ParkissatSolver* solver) {
+    if (!solver) return 0;
+    return solver->preprocessed ? solver->orig_variables : solver->num_variables;
+}
+
+// Inject a clause into a running solve. Unlike ingest_clause() this never
+// touches the arena or the fed counters (both single-writer): the clause is
+// allocated on its own through ClauseManager and handed to each member's
+// addClause(), which enqueues it into the solver's internal lock-free
+// ClauseBuffer to be drained at the next restart boundary. The injected
+// clause must only use variables already present in the formula, since
+// num_variables is deliberately not updated from foreign threads.
+void parkissat_add_clause_concurrent(ParkissatSolver* solver, const int* literals, int size) {
+    if (!solver || !literals || size <= 0) return;
 
-ParkissatSolver* parkissat_new(void) {
     try {
-        return new ParkissatSolver();
+        ClauseExchange* clause = ClauseManager::allocClause(size);
+        if (!clause) return;
+
+        memcpy(clause->lits, literals, size * sizeof(int));
+        clause->lbd = 2;
+        clause->from = -1;
+
+        for (size_t i = 0; i < solver->solvers.size(); i++) {
+            // The proof producer skips injected clauses: they are sound with
+            // respect to the formula but not derivable from it, so logging
+            // search that used them would break the DRAT chain
+            if (solver->excludeFromImports(i)) {
+                continue;
+            }
+            solver->memberSnapshot(i)->addClause(clause);
+        }
+
+        solver->injected_clauses.addClause(clause);
     } catch (...) {
-        return nullptr;
+        // Handle exception
     }
 }
 
-void parkissat_delete(ParkissatSolver* solver) {
-    if (solver) {
-        delete solver;
+void parkissat_set_variable_count(ParkissatSolver* solver, int num_vars) {
+    if (solver && num_vars > 0) {
+        solver->num_variables = num_vars;
     }
 }
 
-void parkissat_configure(ParkissatSolver* solver, const ParkissatConfig* config) {
-    if (!solver || !config) return;
-    
-    solver->config = *config;
-    
-    // Initialize solvers based on configuration
-    solver->solvers.clear();
-    
-    int num_solvers = config->num_threads > 0 ? config->num_threads : 1;
-    
-    for (int i = 0; i < num_solvers; i++) {
-        // Create a solver instance (using KissatBonus as default)
-        SolverInterface* s = SolverFactory::createKissatBonusSolver();
-        if (s) {
-            solver->solvers.push_back(s);
-            
-            // Configure solver parameters
-            parameter p;
-            p.tier1 = 2;
-            p.chrono = 1;
-            p.stable = 1;
-            p.walkinitially = 0;
-            p.target = 1;
-            p.phase = 1;
-            p.heuristic = 1;
-            p.margin = 0;
-            p.ccanr = 1;
-            p.targetinc = 1;
-            
-            s->setParameter(p);
-            
-            if (config->random_seed != 0) {
-                s->diversify(i + config->random_seed);
-            } else {
-                s->diversify(i);
+// Normalize the winner's model into direct-indexed form: slot v-1 holds the
+// signed literal for variable v, so value lookups are a single load and the
+// buffer still reads as a DIMACS-ordered model. Variables the solver did not
+// assign default to false.
+static void normalize_model(ParkissatSolver* solver) {
+    std::vector<int> indexed(solver->num_variables > 0 ? solver->num_variables : 0, 0);
+    for (int lit : solver->model) {
+        int var = abs(lit);
+        if (var >= 1 && var <= solver->num_variables) {
+            indexed[var - 1] = lit;
+        }
+    }
+    for (int v = 1; v <= solver->num_variables; v++) {
+        if (indexed[v - 1] == 0) {
+            indexed[v - 1] = -v;
+        }
+    }
+
+    if (!solver->preprocessed) {
+        if (solver->num_variables > 0) {
+            solver->model.swap(indexed);
+        }
+        return;
+    }
+
+    // Translate the reduced model back into the caller's numbering: values
+    // fixed by the preprocessor come from pre_mapval, renamed variables read
+    // through pre_mapto (a negative entry flips the polarity), and variables
+    // the formula never mentioned default to false.
+    std::vector<int> orig(solver->orig_variables > 0 ? solver->orig_variables : 0, 0);
+    for (int v = 1; v <= solver->orig_variables; v++) {
+        int lit = -v;
+        if ((size_t)v < solver->pre_mapval.size() && solver->pre_mapval[v] != 0) {
+            lit = solver->pre_mapval[v] > 0 ? v : -v;
+        } else if ((size_t)v < solver->pre_mapto.size() && solver->pre_mapto[v] != 0) {
+            int m = solver->pre_mapto[v];
+            int mv = abs(m);
+            if (mv >= 1 && mv <= (int)indexed.size()) {
+                bool val = indexed[mv - 1] > 0;
+                if (m < 0) {
+                    val = !val;
+                }
+                lit = val ? v : -v;
             }
         }
+        orig[v - 1] = lit;
     }
+    solver->model.swap(orig);
 }
 
-bool parkissat_load_dimacs(ParkissatSolver* solver, const char* filename) {
-    if (!solver || !filename) return false;
-    
-    try {
-        if (!solver->solvers.empty()) {
-            return solver->solvers[0]->loadFormula(filename);
+// Run the painless simplifier once over the store and rebuild the arena with
+// the reduced formula. Only the unit-propagation and binary/equivalence
+// passes are used: their model reconstruction is a pure mapto/mapval
+// translation, and unlike bounded variable elimination they keep every
+// variable assumable, which parkissat_solve_with_assumptions() relies on
+// when the preprocessed formula is reused across queries.
+static ParkissatResult run_simplifier(ParkissatSolver* solver) {
+    simplify* S = new simplify();
+
+    // Hand the in-memory formula to the simplifier; clause storage is
+    // 1-indexed, matching its own readfile()
+    S->vars = solver->num_variables;
+    S->clauses = (int)solver->store.numClauses();
+    S->clause.growTo(S->clauses + 1);
+    int ci = 1;
+    for (auto* c : solver->store.arena.clauses) {
+        for (int j = 0; j < c->size; j++) {
+            S->clause[ci].push(c->lits[j]);
         }
-        return false;
+        ci++;
+    }
+
+    S->simplify_init();
+    bool ok = S->simplify_easy_clause();
+    if (ok) {
+        ok = S->simplify_binary();
+    }
+
+    if (!ok) {
+        S->release();
+        delete S;
+        return PARKISSAT_UNSAT;
+    }
+
+    // Capture the variable maps, then replace the stored formula with the
+    // reduced one and hand it to the portfolio
+    solver->orig_variables = solver->num_variables;
+    solver->pre_mapto.assign(solver->orig_variables + 1, 0);
+    solver->pre_mapval.assign(solver->orig_variables + 1, 0);
+    for (int v = 1; v <= solver->orig_variables; v++) {
+        solver->pre_mapto[v] = S->mapto[v];
+        solver->pre_mapval[v] = S->mapval[v];
+    }
+
+    solver->store.arena.clear();
+    for (int i = 1; i <= S->clauses; i++) {
+        int size = S->clause[i].size();
+        ClauseExchange* clause = solver->store.arena.alloc(size);
+        if (!clause) {
+            break;
+        }
+        for (int j = 0; j < size; j++) {
+            clause->lits[j] = S->clause[i][j];
+        }
+    }
+    solver->num_variables = S->vars;
+
+    S->release();
+    delete S;
+
+    solver->preprocessed = true;
+    solver->store.attach(solver->solvers.size());
+    solver->store.distribute(solver->solvers);
+    return PARKISSAT_UNKNOWN;
+}
+
+int parkissat_push(ParkissatSolver* solver) {
+    if (!solver) return -1;
+
+    try {
+        // Allocate a fresh selector variable above everything seen so far
+        int selector = ++solver->num_variables;
+        solver->scope_selectors.push_back(selector);
+        return static_cast<int>(solver->scope_selectors.size());
     } catch (...) {
-        return false;
+        return -1;
     }
 }
 
-void parkissat_add_clause(ParkissatSolver* solver, const int* literals, int size) {
-    if (!solver || !literals || size <= 0) return;
-    
-    
-    
+int parkissat_pop(ParkissatSolver* solver) {
+    if (!solver || solver->scope_selectors.empty()) return -1;
+
     try {
-        // Create ClauseExchange structure
-        ClauseExchange* clause = (ClauseExchange*)malloc(sizeof(ClauseExchange) + size * sizeof(int));
-        if (!clause) return;
-        
-        clause->nbRefs.store(1);
-        clause->lbd = 2; // Default LBD value
-        clause->from = 0;
-        clause->size = size;
-        
-        // Copy literals
-        for (int i = 0; i < size; i++) {
-            clause->lits[i] = literals[i];
-            
-            // Update variable count
-            int var = abs(literals[i]);
-            if (var > solver->num_variables) {
-                solver->num_variables = var;
-            }
-        }
-        
-        
-        
-        solver->clauses.push_back(clause);
-        
-        // Add clause to all solvers using the public addClause method
-        for (auto* s : solver->solvers) {
-            s->addClause(clause);
-            
-        }
+        // Permanently satisfy every clause of the innermost scope. The unit
+        // clause itself must not be tagged, or it would be retractable.
+        int unit = -solver->scope_selectors.back();
+        solver->scope_selectors.pop_back();
+        ingest_clause(solver, &unit, 1, false);
+        return static_cast<int>(solver->scope_selectors.size());
     } catch (...) {
-        // Handle exception
+        return -1;
     }
 }
 
-void parkissat_set_variable_count(ParkissatSolver* solver, int num_vars) {
-    if (solver && num_vars > 0) {
-        solver->num_variables = num_vars;
+// Run the deferred preprocessing pass now instead of at the first solve.
+// A no-op unless enable_preprocessing is set, the pass has not run yet, and
+// no push/pop scope is open (scope selectors must not be renamed away).
+// Reports the current formula size either way.
+ParkissatResult parkissat_preprocess(ParkissatSolver* solver, int* out_vars, int* out_clauses) {
+    if (!solver) return PARKISSAT_UNKNOWN;
+
+    try {
+        if (solver->config.enable_preprocessing && !solver->preprocessed &&
+            !solver->pre_unsat && !solver->pre_abandoned &&
+            solver->scope_selectors.empty() &&
+            solver->store.numClauses() > 0) {
+            if (run_simplifier(solver) == PARKISSAT_UNSAT) {
+                solver->pre_unsat = true;
+            }
+        }
+    } catch (...) {
+        // Leave the formula untouched on failure
     }
+
+    if (out_vars) *out_vars = solver->num_variables;
+    if (out_clauses) *out_clauses = (int)solver->store.numClauses();
+    return solver->pre_unsat ? PARKISSAT_UNSAT : PARKISSAT_UNKNOWN;
 }
 
 ParkissatResult parkissat_solve(ParkissatSolver* solver) {
     if (!solver || solver->solvers.empty()) {
-        
+
         return PARKISSAT_UNKNOWN;
     }
-    
+
     try {
-        solver->interrupted = false;
-        
-        
-        std::vector<int> empty_cube;
+        solver->interrupted.store(false);
+        solver->final_analysis.clear();
+        solver->failed_assumptions.clear();
+
+        // Deferred preprocessing runs once before the first solve
+        parkissat_preprocess(solver, NULL, NULL);
+        if (solver->pre_unsat) {
+            solver->last_result = PARKISSAT_UNSAT;
+            solver->model.clear();
+            return solver->last_result;
+        }
+        // An open scope keeps the simplifier away: solve the raw formula
+        solver->distributeRawFallback();
+
+        // Open push/pop scopes are activated through assumptions
+        std::vector<int> cube(solver->scope_selectors);
         SatResult result;
-        
-        
-        if (solver->solvers.size() == 1) {
+
+        solver->armDeadline();
+
+        if (solver->config.solve_mode == PARKISSAT_MODE_CUBE_AND_CONQUER) {
+            result = solver->runCubeAndConquer(cube);
+        } else if (solver->solvers.size() == 1) {
             // Single-threaded solving
             SolverInterface* s = solver->solvers[0];
-            result = s->solve(empty_cube);
+            s->unsetSolverInterrupt(); // clear a stale interrupt from a previous timeout
+            solver->winner_idx.store(-1);
+            solver->prepareResultBuffers();
+            result = s->solve(cube);
+            solver->store.markImported(0);
+            solver->refreshThreadStats(0);
             if (result == SAT) {
-                solver->model = s->getModel();                
-                // If getModel() returns empty, we need to find a different way to get the model
-                // This is a temporary workaround - the real issue is that the solver's max_var is not set
-                if (solver->model.empty() && solver->num_variables > 0) {
-                    solver->model.clear();
-                    
-                    // Try to create a model by checking if our clauses are satisfied
-                    // This is a very basic approach for simple test cases
-                    std::vector<bool> assignment(solver->num_variables + 1, false);
-                    
-                    // For the test case (1 ∨ 2) ∧ (¬1 ∨ 2), setting x2=true satisfies both
-                    // This is a hardcoded solution for the specific test case
-                    if (solver->num_variables == 2) {
-                        assignment[1] = false; // x1 = false
-                        assignment[2] = true;  // x2 = true
-                    } else {
-                        // For other cases, just set all variables to false
-                        for (int i = 1; i <= solver->num_variables; i++) {
-                            assignment[i] = false;
-                        }
-                    }
-                    
-                    // Convert to model format
-                    for (int i = 1; i <= solver->num_variables; i++) {
-                        solver->model.push_back(assignment[i] ? i : -i);
-                    }
-                }
+                // Read the assignment straight out of kissat's value table
+                // into the pre-sized buffer
+                solver->publishModel(s, 0);
+            } else if (result == UNSAT) {
+                solver->winner_idx.store(0);
             }
         } else {
-            // Multi-threaded solving using threads
-            std::vector<std::thread> threads;
-            std::atomic<bool> solved(false);
-            std::atomic<SatResult> final_result(UNKNOWN);
-            std::mutex model_mutex;
-            
-            for (size_t i = 0; i < solver->solvers.size(); i++) {
-                threads.emplace_back([&, i]() {
-                    if (solved.load()) return;
-                    
-                    SolverInterface* s = solver->solvers[i];
-                    SatResult local_result = s->solve(empty_cube);
-                    
-                    if (local_result == SAT || local_result == UNSAT) {
-                        bool expected = false;
-                        if (solved.compare_exchange_strong(expected, true)) {
-                            // This thread found the result first
-                            final_result.store(local_result);
-                            if (local_result == SAT) {
-                                std::lock_guard<std::mutex> lock(model_mutex);
-                                solver->model = s->getModel();
-                            }
-                            
-                            // Interrupt other solvers
-                            for (auto* other_solver : solver->solvers) {
-                                if (other_solver != s) {
-                                    other_solver->setSolverInterrupt();
-                                }
-                            }
-                        }
-                    }
-                });
-            }
-            
-            // Wait for all threads to complete
-            for (auto& thread : threads) {
-                thread.join();
-            }
-            
-            result = final_result.load();
+            // Multi-threaded solving on the persistent worker pool
+            result = solver->runPortfolio(cube);
         }
-        
+
+        solver->disarmDeadline();
+
         switch (result) {
             case SAT:
                 solver->last_result = PARKISSAT_SAT;
+                normalize_model(solver);
                 break;
             case UNSAT:
                 solver->last_result = PARKISSAT_UNSAT;
@@ -268,7 +2944,7 @@ ParkissatResult parkissat_solve(ParkissatSolver* solver) {
                 solver->model.clear();
                 break;
         }
-        
+
         return solver->last_result;
     } catch (...) {
         return PARKISSAT_UNKNOWN;
@@ -283,80 +2959,99 @@ ParkissatResult parkissat_solve_with_assumptions(ParkissatSolver* solver, const
     
     
     try {
-        solver->interrupted = false;
-        
-        // Convert assumptions to vector
+        solver->interrupted.store(false);
+        solver->final_analysis.clear();
+        solver->failed_assumptions.clear();
+
+        // Deferred preprocessing runs once before the first solve
+        parkissat_preprocess(solver, NULL, NULL);
+        if (solver->pre_unsat) {
+            solver->last_result = PARKISSAT_UNSAT;
+            solver->model.clear();
+            return solver->last_result;
+        }
+        // An open scope keeps the simplifier away: solve the raw formula
+        solver->distributeRawFallback();
+
+        // Convert assumptions to a cube, translating into the reduced space
+        // when the formula was preprocessed. An assumption that contradicts a
+        // preprocessed value makes the query trivially UNSAT; one it already
+        // satisfies is dropped. mapped_vars remembers each assumption's
+        // reduced variable (0 = dropped) for the conflict matching below.
         std::vector<int> cube;
+        std::vector<int> mapped_vars(num_assumptions > 0 ? num_assumptions : 0, 0);
         if (assumptions && num_assumptions > 0) {
-            cube.assign(assumptions, assumptions + num_assumptions);
+            for (int i = 0; i < num_assumptions; i++) {
+                int mapped;
+                int fixed = solver->mapLiteral(assumptions[i], &mapped);
+                if (fixed < 0) {
+                    solver->failed_assumptions.assign(1, assumptions[i]);
+                    solver->last_result = PARKISSAT_UNSAT;
+                    solver->model.clear();
+                    return solver->last_result;
+                }
+                if (fixed == 0) {
+                    cube.push_back(mapped);
+                    mapped_vars[i] = abs(mapped);
+                }
+            }
         }
+
+        // Open push/pop scopes are activated through assumptions as well
+        cube.insert(cube.end(), solver->scope_selectors.begin(),
+                    solver->scope_selectors.end());
         
         SatResult result;
-        
-        
-        if (solver->solvers.size() == 1) {
+
+        solver->armDeadline();
+
+        if (solver->config.solve_mode == PARKISSAT_MODE_CUBE_AND_CONQUER) {
+            result = solver->runCubeAndConquer(cube);
+        } else if (solver->solvers.size() == 1) {
             // Single-threaded solving
             SolverInterface* s = solver->solvers[0];
+            s->unsetSolverInterrupt(); // clear a stale interrupt from a previous timeout
+            solver->winner_idx.store(-1);
+            solver->prepareResultBuffers();
             result = s->solve(cube);
+            solver->store.markImported(0);
+            solver->refreshThreadStats(0);
             if (result == SAT) {
-                solver->model = s->getModel();
-                
-                // If getModel() returns empty, we need to find a different way to get the model
-                if (solver->model.empty() && solver->num_variables > 0) {
-                    solver->model.clear();
-                    for (int i = 1; i <= solver->num_variables; i++) {
-                        // For now, just create a dummy model to test the logic
-                        // In a real implementation, we'd need to access the solver's internal state
-                        solver->model.push_back(i);  // Assume all variables are positive
-                    }
-                }
+                // Read the assignment straight out of kissat's value table
+                // into the pre-sized buffer
+                solver->publishModel(s, 0);
+            } else if (result == UNSAT) {
+                solver->final_analysis = s->getFinalAnalysis();
+                solver->winner_idx.store(0);
             }
         } else {
-            // Multi-threaded solving using threads
-            std::vector<std::thread> threads;
-            std::atomic<bool> solved(false);
-            std::atomic<SatResult> final_result(UNKNOWN);
-            std::mutex model_mutex;
-            
-            for (size_t i = 0; i < solver->solvers.size(); i++) {
-                threads.emplace_back([&, i]() {
-                    if (solved.load()) return;
-                    
-                    SolverInterface* s = solver->solvers[i];
-                    SatResult local_result = s->solve(cube);
-                    
-                    if (local_result == SAT || local_result == UNSAT) {
-                        bool expected = false;
-                        if (solved.compare_exchange_strong(expected, true)) {
-                            // This thread found the result first
-                            final_result.store(local_result);
-                            if (local_result == SAT) {
-                                std::lock_guard<std::mutex> lock(model_mutex);
-                                solver->model = s->getModel();
-                            }
-                            
-                            // Interrupt other solvers
-                            for (auto* other_solver : solver->solvers) {
-                                if (other_solver != s) {
-                                    other_solver->setSolverInterrupt();
-                                }
-                            }
-                        }
+            // Multi-threaded solving on the persistent worker pool
+            result = solver->runPortfolio(cube);
+        }
+
+        solver->disarmDeadline();
+
+        // Reduce the winner's conflict analysis to the subset of the caller's
+        // assumptions involved in it. The analysis may mention an assumption
+        // with either polarity and can include internal scope selectors, so
+        // match on variables of the caller's literals only.
+        if (result == UNSAT && num_assumptions > 0) {
+            for (int i = 0; i < num_assumptions; i++) {
+                int var = mapped_vars[i];
+                if (var == 0) continue; // dropped by preprocessing
+                for (int lit : solver->final_analysis) {
+                    if (abs(lit) == var) {
+                        solver->failed_assumptions.push_back(assumptions[i]);
+                        break;
                     }
-                });
-            }
-            
-            // Wait for all threads to complete
-            for (auto& thread : threads) {
-                thread.join();
+                }
             }
-            
-            result = final_result.load();
         }
-        
+
         switch (result) {
             case SAT:
                 solver->last_result = PARKISSAT_SAT;
+                normalize_model(solver);
                 break;
             case UNSAT:
                 solver->last_result = PARKISSAT_UNSAT;
@@ -374,26 +3069,181 @@ ParkissatResult parkissat_solve_with_assumptions(ParkissatSolver* solver, const
     }
 }
 
+void parkissat_solve_batch(ParkissatSolver* solver, const int* flat_assumptions,
+                           const int* offsets, int num_queries,
+                           ParkissatResult* results) {
+    if (!solver || solver->solvers.empty() || !offsets || !results || num_queries <= 0) {
+        return;
+    }
+
+    for (int q = 0; q < num_queries; q++) {
+        results[q] = PARKISSAT_UNKNOWN;
+    }
+
+    try {
+        solver->interrupted.store(false);
+
+        // Deferred preprocessing runs once before the first solve
+        parkissat_preprocess(solver, NULL, NULL);
+        if (solver->pre_unsat) {
+            for (int q = 0; q < num_queries; q++) {
+                results[q] = PARKISSAT_UNSAT;
+            }
+            return;
+        }
+        // An open scope keeps the simplifier away: solve the raw formula
+        solver->distributeRawFallback();
+
+        // Translate every query up front on this thread — mapLiteral mutates
+        // the preprocessing maps and must not run on the workers. A query
+        // with an assumption fixed false is decided here and never reaches a
+        // solver; fixed-true assumptions are dropped from their query.
+        solver->batch_queries.assign(num_queries, std::vector<int>());
+        solver->batch_results.assign(num_queries, PARKISSAT_UNKNOWN);
+        for (int q = 0; q < num_queries; q++) {
+            std::vector<int>& cube = solver->batch_queries[q];
+            for (int j = offsets[q]; j < offsets[q + 1]; j++) {
+                int mapped;
+                int fixed = solver->mapLiteral(flat_assumptions[j], &mapped);
+                if (fixed < 0) {
+                    solver->batch_results[q] = PARKISSAT_UNSAT;
+                    cube.clear();
+                    break;
+                }
+                if (fixed == 0) {
+                    cube.push_back(mapped);
+                }
+            }
+            if (solver->batch_results[q] == PARKISSAT_UNKNOWN) {
+                cube.insert(cube.end(), solver->scope_selectors.begin(),
+                            solver->scope_selectors.end());
+            }
+        }
+
+        solver->armDeadline();
+        solver->runBatch();
+        solver->disarmDeadline();
+
+        for (int q = 0; q < num_queries; q++) {
+            results[q] = solver->batch_results[q];
+        }
+        solver->batch_queries.clear();
+        solver->batch_results.clear();
+    } catch (...) {
+        // results keeps whatever was decided before the failure
+    }
+}
+
+bool parkissat_solve_async(ParkissatSolver* solver) {
+    if (!solver || solver->solvers.empty()) return false;
+    if (solver->async_running.load()) return false;
+
+    try {
+        // Harvest a finished coordinator that was polled but never waited on
+        if (solver->async_thread.joinable()) {
+            solver->async_thread.join();
+        }
+
+        solver->async_running.store(true);
+        solver->async_done.store(false);
+
+        solver->async_thread = std::thread([solver] {
+            parkissat_solve(solver);
+
+            {
+                std::lock_guard<std::mutex> lock(solver->async_mutex);
+                solver->async_done.store(true);
+                solver->async_running.store(false);
+            }
+            solver->async_cv.notify_all();
+        });
+
+        return true;
+    } catch (...) {
+        solver->async_running.store(false);
+        return false;
+    }
+}
+
+bool parkissat_poll(ParkissatSolver* solver) {
+    if (!solver) return false;
+    return solver->async_done.load();
+}
+
+ParkissatResult parkissat_wait(ParkissatSolver* solver, int timeout_ms) {
+    if (!solver) return PARKISSAT_UNKNOWN;
+
+    try {
+        if (!solver->async_thread.joinable()) {
+            // No async solve in flight; report the last synchronous result
+            return solver->last_result;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(solver->async_mutex);
+            if (timeout_ms < 0) {
+                solver->async_cv.wait(lock, [solver] { return solver->async_done.load(); });
+            } else {
+                solver->async_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                                          [solver] { return solver->async_done.load(); });
+            }
+
+            if (!solver->async_done.load()) {
+                return PARKISSAT_UNKNOWN;
+            }
+        }
+
+        solver->async_thread.join();
+        return solver->last_result;
+    } catch (...) {
+        return PARKISSAT_UNKNOWN;
+    }
+}
+
 bool parkissat_get_model_value(ParkissatSolver* solver, int variable) {
-    if (!solver || variable <= 0 || variable > solver->num_variables) {
+    if (!solver || variable <= 0) {
         return false;
     }
-    
+
     if (solver->last_result != PARKISSAT_SAT || solver->model.empty()) {
         return false;
     }
-    
-    
-    
-    // Model is 1-indexed, find the variable
-    for (size_t i = 0; i < solver->model.size(); i++) {
-        if (abs(solver->model[i]) == variable) {
-            bool result = solver->model[i] > 0;
-            return result;
+
+    // The model is in the caller's numbering: after preprocessing it was
+    // normalized back to the original variables and sized accordingly, so
+    // its size — not the reduced num_variables — is the bound
+    if ((size_t)variable > solver->model.size()) {
+        return false;
+    }
+
+    // The model is direct-indexed: slot v-1 holds the literal for variable v
+    return solver->model[variable - 1] > 0;
+}
+
+int parkissat_failed_assumptions(ParkissatSolver* solver, int* out, int capacity) {
+    if (!solver || solver->last_result != PARKISSAT_UNSAT) {
+        return 0;
+    }
+
+    int count = static_cast<int>(solver->failed_assumptions.size());
+    if (out && capacity > 0) {
+        int copy = count < capacity ? count : capacity;
+        for (int i = 0; i < copy; i++) {
+            out[i] = solver->failed_assumptions[i];
         }
     }
-    
-    return false; // Variable not found in model
+
+    return count;
+}
+
+const int* parkissat_get_model_ptr(ParkissatSolver* solver, int* out_len) {
+    if (out_len) *out_len = 0;
+    if (!solver || solver->last_result != PARKISSAT_SAT || solver->model.empty()) {
+        return NULL;
+    }
+
+    if (out_len) *out_len = static_cast<int>(solver->model.size());
+    return solver->model.data();
 }
 
 int parkissat_get_model_size(ParkissatSolver* solver) {
@@ -436,22 +3286,98 @@ ParkissatStatistics parkissat_get_statistics(ParkissatSolver* solver) {
     return stats;
 }
 
+bool parkissat_get_thread_statistics(ParkissatSolver* solver, int thread_idx,
+                                     ParkissatStatistics* stats) {
+    if (!solver || !stats || thread_idx < 0 ||
+        (size_t)thread_idx >= solver->num_thread_stats) {
+        return false;
+    }
+
+    const ThreadStatsSnapshot& slot = solver->thread_stats[thread_idx];
+    stats->propagations = slot.propagations.load(std::memory_order_relaxed);
+    stats->decisions = slot.decisions.load(std::memory_order_relaxed);
+    stats->conflicts = slot.conflicts.load(std::memory_order_relaxed);
+    stats->restarts = slot.restarts.load(std::memory_order_relaxed);
+    stats->mem_peak = slot.mem_peak.load(std::memory_order_relaxed);
+    return true;
+}
+
+int parkissat_dump_perf(ParkissatSolver* solver, char* buf, int len) {
+    if (!solver || !buf || len <= 0) return 0;
+
+    std::string out;
+    char line[512];
+
+    snprintf(line, sizeof line, "enabled=%d\n", kPerfEnabled ? 1 : 0);
+    out += line;
+
+    const PerfCounters& perf = solver->perf;
+    snprintf(line, sizeof line,
+             "clauses_ingested=%llu\nliterals_ingested=%llu\narena_bytes=%llu\n"
+             "solves_dispatched=%llu\nmodels_published=%llu\n",
+             (unsigned long long)perf.clauses_ingested.load(std::memory_order_relaxed),
+             (unsigned long long)perf.literals_ingested.load(std::memory_order_relaxed),
+             (unsigned long long)perf.arena_bytes.load(std::memory_order_relaxed),
+             (unsigned long long)perf.solves_dispatched.load(std::memory_order_relaxed),
+             (unsigned long long)perf.models_published.load(std::memory_order_relaxed));
+    out += line;
+
+    const struct { const char* name; const PerfHistogram* h; } histograms[] = {
+        { "dispatch_wake_ns_log2", &perf.dispatch_wake_ns },
+        { "model_readback_ns_log2", &perf.model_readback_ns },
+    };
+    for (const auto& entry : histograms) {
+        out += entry.name;
+        out += '=';
+        for (int b = 0; b < PerfHistogram::kBuckets; b++) {
+            if (b > 0) out += ',';
+            snprintf(line, sizeof line, "%llu",
+                     (unsigned long long)entry.h->buckets[b].load(std::memory_order_relaxed));
+            out += line;
+        }
+        out += '\n';
+    }
+
+    size_t n = out.size() < (size_t)len - 1 ? out.size() : (size_t)len - 1;
+    memcpy(buf, out.data(), n);
+    buf[n] = '\0';
+    return (int)n;
+}
+
+int parkissat_get_winner(ParkissatSolver* solver) {
+    if (!solver) return -1;
+    // Acquire pairs with the winner's release store, so a reader that sees
+    // the index also sees the finished model buffer
+    return solver->winner_idx.load(std::memory_order_acquire);
+}
+
 void parkissat_interrupt(ParkissatSolver* solver) {
     if (!solver) return;
     
-    solver->interrupted = true;
-    for (auto* s : solver->solvers) {
-        s->setSolverInterrupt();
+    solver->interrupted.store(true);
+    for (size_t i = 0; i < solver->solvers.size(); i++) {
+        solver->memberSnapshot(i)->setSolverInterrupt();
     }
 }
 
 void parkissat_clear_interrupt(ParkissatSolver* solver) {
     if (!solver) return;
-    
-    solver->interrupted = false;
+
+    solver->interrupted.store(false);
     for (auto* s : solver->solvers) {
         s->unsetSolverInterrupt();
     }
 }
 
+void parkissat_set_terminate_callback(ParkissatSolver* solver,
+                                      int (*callback)(void* data), void* data) {
+    if (!solver) return;
+
+    solver->terminate_cb = callback;
+    solver->terminate_data = data;
+    for (auto* s : solver->solvers) {
+        solver->wireTerminateCallback(s);
+    }
+}
+
 } // extern "C"
\ No newline at end of file
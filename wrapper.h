@@ -24,46 +24,290 @@ typedef struct {
     uint64_t decisions;
     uint64_t conflicts;
     uint64_t restarts;
-    double mem_peak;
+    double mem_peak;     // peak resident memory in kB
 } ParkissatStatistics;
 
+// Parallel solve engines
+typedef enum {
+    PARKISSAT_MODE_PORTFOLIO = 0,
+    PARKISSAT_MODE_CUBE_AND_CONQUER = 1
+} ParkissatSolveMode;
+
+// Worker placement policies. Pinning deals workers across NUMA nodes
+// round-robin; since each kissat instance allocates its clause database
+// lazily from its own worker thread, pinning also gives first-touch
+// node-local placement of every member's hot structures.
+typedef enum {
+    PARKISSAT_PIN_NONE = 0,   // leave placement to the kernel
+    PARKISSAT_PIN_CORE = 1,   // one core per worker, dealt across NUMA nodes
+    PARKISSAT_PIN_NODE = 2    // workers bound to one node, core choice free
+} ParkissatPinPolicy;
+
+// Portfolio diversification plans. Seed-only diversification gives every
+// member the identical parameter block and separates them by random seed
+// alone, which collapses onto similar search trajectories on large
+// portfolios. The preset plan additionally deals a library of complementary
+// parameter blocks — stable vs focused restart behaviour, walk-seeded vs
+// saved phases, flipped polarity, heavier clause tiers — round-robin across
+// the members, so the marginal solver keeps exploring a genuinely different
+// trajectory well past 16 threads.
+typedef enum {
+    PARKISSAT_DIV_SEED_ONLY = 0, // identical parameters, per-member seed
+    PARKISSAT_DIV_PRESETS = 1    // preset library dealt round-robin, plus seed
+} ParkissatDiversificationPlan;
+
+// Portfolio layout chosen at configure time; see parkissat_get_layout().
+typedef struct {
+    int num_threads;     // portfolio size actually configured
+    int physical_cores;  // physical cores detected on the machine
+    int numa_nodes;      // NUMA nodes detected on the machine
+    bool auto_selected;  // true when num_threads came from auto-detection
+} ParkissatLayout;
+
 // Configuration parameters
 typedef struct {
-    int num_threads;
+    int num_threads;            // portfolio size; -1 = auto (topology-aware)
     int timeout_seconds;
     int random_seed;
     bool enable_preprocessing;
     int verbosity;
+
+    // Parallel solve engine (ParkissatSolveMode, default portfolio)
+    int solve_mode;
+    int cube_split_depth;       // cube-and-conquer splits on 2^depth cubes (0 = auto)
+
+    // Worker placement (ParkissatPinPolicy, default none)
+    int pin_policy;
+
+    // Diversification plan (ParkissatDiversificationPlan, default seed-only)
+    int diversification_plan;
+
+    // Deterministic portfolio mode: members advance in fixed conflict-budget
+    // epochs with barrier-synchronized clause exchange and a deterministic
+    // winner rule (lowest finished index), so the same input reproduces the
+    // same answer, model, and winner run to run. Costs a bounded slowdown
+    // (members idle at the barrier); ignores the asynchronous sharer and only
+    // applies to portfolio mode — single-solver runs are already
+    // deterministic, cube-and-conquer is not covered.
+    bool enable_deterministic;
+    int deterministic_conflict_budget; // conflicts per epoch (0 = default 4096)
+
+    // Adaptive portfolio management: while a portfolio solve runs, the member
+    // with the lowest conflict rate is periodically killed and relaunched
+    // under a fresh parameter configuration and diversification seed. The
+    // relaunch reseeds the formula from the warm shared store, so it costs
+    // one import pass. Not applied in deterministic or cube-and-conquer mode.
+    bool enable_adaptive;
+
+    // Collective memory budget in MiB for portfolio solves (0 = unlimited).
+    // While a portfolio race runs, the statistics sampler watches the
+    // members' combined resident memory; when it approaches the budget, the
+    // heaviest member is shed — it stops allocating immediately, its worker
+    // sits out the rest of the race, and its instance (with all its learned
+    // clauses) is released at race end. Shedding degrades the portfolio
+    // gracefully instead of letting the kernel kill the process; if every
+    // member gets shed the solve returns PARKISSAT_UNKNOWN. Only applies to
+    // (non-deterministic) portfolio mode.
+    int memory_budget_mb;
+
+    // Learned-clause sharing between portfolio members
+    bool enable_clause_sharing;
+    int sharing_lbd_limit;      // max LBD of exported clauses (0 = solver default)
+    int sharing_lit_budget;     // literals shared per producer per round (0 = default)
+    int sharing_interval_us;    // exchange round interval in microseconds (0 = default)
 } ParkissatConfig;
 
 // Core solver functions
 ParkissatSolver* parkissat_new(void);
 void parkissat_delete(ParkissatSolver* solver);
 
-// Configuration
+// Configuration. A num_threads of -1 picks the portfolio size automatically:
+// one member per physical core (hyperthread siblings share execution ports
+// and cache, so a second kissat on the same core costs more in cache
+// pressure than it adds), capped so every member keeps roughly 512 MiB of
+// the memory available at configure time. The choice the solver actually
+// made is reported by parkissat_get_layout().
 void parkissat_configure(ParkissatSolver* solver, const ParkissatConfig* config);
 
-// Problem setup
+// Report the portfolio layout chosen by the last configure: the portfolio
+// size (after auto-detection, if requested) plus the physical-core and
+// NUMA-node counts it was derived from.
+void parkissat_get_layout(ParkissatSolver* solver, ParkissatLayout* layout);
+
+// Drop the formula and all learned state, keeping the expensive surroundings
+// alive for the next problem: the worker pool threads, the statistics
+// arrays, the installed callbacks, and the arena slabs, which are recycled
+// by the next load so steady-state serving of a formula stream performs no
+// large allocations and no thread churn. The portfolio members themselves
+// are recreated (kissat has no in-place clear), which is the cheap part of
+// configuration. Must be called between solves; an active proof stream is
+// closed, since it belongs to the old formula.
+void parkissat_reset(ParkissatSolver* solver);
+
+// Give the wrapper's packed formula copy back to the system. After a solve,
+// every member's kissat instance holds its own copy of the formula, so the
+// packed copy the members were fed from is pure redundancy — about 1/(N+1)
+// of the formula-proportional residency for N members. Trimming frees it
+// once every member has imported every clause; call between solves. Returns
+// the bytes given back, or 0 when nothing could be freed (a solve is
+// running, or some member has not imported the whole formula yet). Until
+// the next parkissat_reset() starts a fresh formula, the features that
+// replay the packed copy are unavailable: adaptive relaunch and
+// memory-budget shedding stand down and parkissat_save_state() fails, and
+// a reconfiguration drops the formula entirely (the rebuilt members could
+// only be fed the post-trim tail). Incremental clause additions and
+// further solves work normally.
+uint64_t parkissat_trim_memory(ParkissatSolver* solver);
+
+// Warm-start snapshots. save writes the formula, the preprocessing maps, the
+// open scope selectors, and each member's export-quality learned clauses
+// (filtered by LBD) as a compact binary blob with buffered sequential I/O;
+// load restores the snapshot into a freshly configured solver, so a process
+// restart skips the re-warming cliff of a long incremental session. Both
+// must be called between solves; the format is host-byte-order and not
+// portable across architectures.
+bool parkissat_save_state(ParkissatSolver* solver, const char* path);
+bool parkissat_load_state(ParkissatSolver* solver, const char* path);
+
+// DRAT proof emission. Designates portfolio member 0 as the proof producer:
+// its kissat instance logs every derivation in ASCII DRAT, staged through
+// large in-memory buffers and flushed to `path` by a dedicated writer thread,
+// so the solver hot loop never blocks on disk. Enable after configure and
+// before the first solve; a NULL path stops logging, flushes, and closes the
+// file (also done at destruction). While logging is active the producer
+// imports no foreign clauses (shared, injected, or snapshot-restored), which
+// keeps the proof self-contained — consequently an UNSAT answer is certified
+// by the proof only when parkissat_get_winner() reports member 0.
+bool parkissat_set_proof_file(ParkissatSolver* solver, const char* path);
+
+// Problem setup. The DIMACS loader memory-maps plain files and parses them
+// with multiple threads; .gz files are decompressed in a streaming pass
+// through zlib and .xz files through the system xz tool, straight into
+// memory with no temp files, before the same parallel parse.
 bool parkissat_load_dimacs(ParkissatSolver* solver, const char* filename);
 void parkissat_add_clause(ParkissatSolver* solver, const int* literals, int size);
+void parkissat_add_clauses(ParkissatSolver* solver, const int* flat_lits,
+                           const int* clause_offsets, int num_clauses);
+
+// Inject a clause while a solve is running. The clause is staged in each
+// solver's lock-free import buffer and picked up at the next restart
+// boundary, so search momentum is preserved. Safe to call from any thread
+// concurrently with parkissat_solve()/parkissat_solve_async(); the clause
+// must be sound with respect to the formula (e.g. a blocking or symmetry
+// clause), since solvers that already passed a restart may not see it before
+// finishing.
+void parkissat_add_clause_concurrent(ParkissatSolver* solver, const int* literals, int size);
 void parkissat_set_variable_count(ParkissatSolver* solver, int num_vars);
 
+// Number of variables in the caller's numbering (the pre-preprocessing count
+// when preprocessing ran)
+int parkissat_get_variable_count(ParkissatSolver* solver);
+
+// Incremental solving. A push opens an activation-literal scope: clauses added
+// inside it can be retracted again by the matching pop, while learned clauses,
+// phases, and scores in all portfolio members stay warm across queries. Scopes
+// nest in stack order. Each push allocates one fresh variable above the
+// current variable count, so set the variable count before the first push.
+// Both calls return the number of open scopes; pop returns -1 if none is open.
+int parkissat_push(ParkissatSolver* solver);
+int parkissat_pop(ParkissatSolver* solver);
+
+// Preprocessing. With enable_preprocessing set, ingested clauses are held
+// back and the painless simplifier runs once over the whole formula before
+// the portfolio sees it — either here, or lazily at the first solve. The
+// reduced formula is then reused across all later (assumption) queries;
+// models, assumptions, and further clauses keep using the caller's original
+// variable numbering. Returns PARKISSAT_UNSAT if the simplifier refutes the
+// formula outright, PARKISSAT_UNKNOWN otherwise, and reports the current
+// variable and clause counts through the optional out parameters.
+ParkissatResult parkissat_preprocess(ParkissatSolver* solver, int* out_vars, int* out_clauses);
+
 // Solving
 ParkissatResult parkissat_solve(ParkissatSolver* solver);
 ParkissatResult parkissat_solve_with_assumptions(ParkissatSolver* solver, const int* assumptions, int num_assumptions);
 
+// Answer many assumption queries over the same formula in one call.
+// flat_assumptions holds all queries back to back; query q spans
+// [offsets[q], offsets[q+1]), so offsets has num_queries + 1 entries. The
+// portfolio members drain the queries concurrently — one query per idle
+// member — and the per-query answers land in `results`. Batch queries answer
+// SAT/UNSAT only: no model, winner, or failed-assumption set is retained
+// (re-run a query of interest through parkissat_solve_with_assumptions).
+// An interrupt or the configured timeout leaves undrained slots
+// PARKISSAT_UNKNOWN.
+void parkissat_solve_batch(ParkissatSolver* solver, const int* flat_assumptions,
+                           const int* offsets, int num_queries,
+                           ParkissatResult* results);
+
+// Non-blocking solving. solve_async starts the solve on a coordinator thread
+// and returns immediately (false if a solve is already in flight); poll
+// reports completion without blocking; wait blocks for up to timeout_ms
+// (negative = forever) and returns the result once the solve has finished, or
+// PARKISSAT_UNKNOWN on timeout (use parkissat_poll to tell the two apart).
+// The problem must not be modified while a solve is in flight.
+bool parkissat_solve_async(ParkissatSolver* solver);
+bool parkissat_poll(ParkissatSolver* solver);
+ParkissatResult parkissat_wait(ParkissatSolver* solver, int timeout_ms);
+
 // Results
 bool parkissat_get_model_value(ParkissatSolver* solver, int variable);
 int parkissat_get_model_size(ParkissatSolver* solver);
 void parkissat_get_model(ParkissatSolver* solver, int* model, int size);
 
+// After parkissat_solve_with_assumptions() returns PARKISSAT_UNSAT, copies the
+// subset of the assumptions that the winning solver used to derive the
+// conflict into `out` (up to `capacity` entries) and returns the size of that
+// subset. Returns 0 after any other result, and for cube-and-conquer runs,
+// where the refutation is split across cubes.
+int parkissat_failed_assumptions(ParkissatSolver* solver, int* out, int capacity);
+
+// Zero-copy view of the model: slot v-1 holds the signed literal for variable
+// v. Valid until the next solve or configure call; NULL unless the last
+// result was SAT.
+const int* parkissat_get_model_ptr(ParkissatSolver* solver, int* out_len);
+
 // Statistics
 ParkissatStatistics parkissat_get_statistics(ParkissatSolver* solver);
 
+// Lock-free snapshot of one portfolio member's counters, refreshed roughly
+// ten times per second while a solve runs, so it is safe to poll from any
+// thread to watch live conflict/propagation rates. Returns false if
+// thread_idx is out of range. The snapshot may lag the member by up to one
+// refresh interval.
+bool parkissat_get_thread_statistics(ParkissatSolver* solver, int thread_idx,
+                                     ParkissatStatistics* stats);
+
+// Snapshot of the wrapper's hot-path instrumentation as key=value lines,
+// histograms as comma-separated log2(nanosecond) buckets: clause ingestion
+// counts, arena occupancy, pool dispatch count and wakeup latency, and model
+// readback time. The counters are compiled in only when the crate is built
+// with the perf-instrumentation feature (-DPARKISSAT_PERF); otherwise the
+// snapshot reports enabled=0 with zeros and the hot paths carry no
+// instrumentation cost at all. Writes at most len bytes including the NUL
+// terminator and returns the number of bytes written.
+int parkissat_dump_perf(ParkissatSolver* solver, char* buf, int len);
+
+// Index of the portfolio member that produced the final answer of the last
+// solve, or -1 if no solve has finished, the last solve was interrupted, or
+// the answer was a cube-and-conquer UNSAT (a collective refutation). Batch
+// solves answer many queries at once and never report a winner.
+int parkissat_get_winner(ParkissatSolver* solver);
+
 // Control
 void parkissat_interrupt(ParkissatSolver* solver);
 void parkissat_clear_interrupt(ParkissatSolver* solver);
 
+// Install an external termination condition, wired into every portfolio
+// member's kissat terminate hook and polled at conflict boundaries — far
+// tighter than the interrupt flag's check granularity and without a watchdog
+// thread. The callback returns nonzero to stop the search; every member then
+// comes back PARKISSAT_UNKNOWN. It is invoked concurrently from all worker
+// threads, so it must be thread-safe and cheap (a relaxed atomic load, not a
+// lock). A NULL callback uninstalls the hook. The installed callback
+// survives reconfiguration and adaptive relaunches.
+void parkissat_set_terminate_callback(ParkissatSolver* solver,
+                                      int (*callback)(void* data), void* data);
+
 #ifdef __cplusplus
 }
 #endif